@@ -474,6 +474,20 @@ namespace embree
     return _mm_popcnt_u64(in);
   }
 #endif
+
+#elif defined(__GNUC__) || defined(__clang__)
+
+  __forceinline size_t popcnt(size_t in) {
+    return __builtin_popcountll(in);
+  }
+
+#else
+
+  __forceinline size_t popcnt(size_t in) {
+    size_t n = 0;
+    for (; in; in &= in-1) n++;
+    return n;
+  }
   
 #endif
 
@@ -20,6 +20,9 @@ namespace embree
   
     virtual RefCount* refInc() { refCounter.fetch_add(1); return this; }
     virtual void refDec() { if (refCounter.fetch_add(-1) == 1) delete this; }
+
+    /*! returns the current number of references */
+    size_t refCount() const { return refCounter.load(); }
   private:
     std::atomic<size_t> refCounter;
   };
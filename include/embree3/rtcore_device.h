@@ -48,7 +48,12 @@ enum RTCDeviceProperty
 
   RTC_DEVICE_PROPERTY_TASKING_SYSTEM        = 128,
   RTC_DEVICE_PROPERTY_JOIN_COMMIT_SUPPORTED = 129,
-  RTC_DEVICE_PROPERTY_PARALLEL_COMMIT_SUPPORTED = 130
+  RTC_DEVICE_PROPERTY_PARALLEL_COMMIT_SUPPORTED = 130,
+
+  RTC_DEVICE_PROPERTY_PACKET_TRAVERSAL_COUNT   = 160,
+  RTC_DEVICE_PROPERTY_PACKET_NODE_VISIT_COUNT  = 161,
+  RTC_DEVICE_PROPERTY_PACKET_ACTIVE_LANE_COUNT = 162,
+  RTC_DEVICE_PROPERTY_PACKET_SWITCH_COUNT      = 163
 };
 
 /* Gets a device property. */
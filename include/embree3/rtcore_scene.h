@@ -21,7 +21,9 @@ enum RTCSceneFlags
   RTC_SCENE_FLAG_DYNAMIC                 = (1 << 0),
   RTC_SCENE_FLAG_COMPACT                 = (1 << 1),
   RTC_SCENE_FLAG_ROBUST                  = (1 << 2),
-  RTC_SCENE_FLAG_CONTEXT_FILTER_FUNCTION = (1 << 3)
+  RTC_SCENE_FLAG_CONTEXT_FILTER_FUNCTION = (1 << 3),
+  RTC_SCENE_FLAG_STATISTICS              = (1 << 4),
+  RTC_SCENE_FLAG_LAZY_BUILD              = (1 << 5)
 };
 
 /* Creates a new scene. */
@@ -60,6 +62,12 @@ RTC_API void rtcCommitScene(RTCScene scene);
 /* Commits the scene from multiple threads. */
 RTC_API void rtcJoinCommitScene(RTCScene scene);
 
+/* Commits multiple scenes concurrently, instanced scenes get committed before the scenes instancing them. */
+RTC_API void rtcCommitScenes(RTCScene* scenes, size_t numScenes);
+
+/* Ends the frame of lazily built scenes, frees the least recently visited ones if the memory budget is exceeded. */
+RTC_API void rtcEvictLazyScenes(RTCDevice device);
+
 
 /* Progress monitor callback function */
 typedef bool (*RTCProgressMonitorFunction)(void* ptr, double n);
@@ -70,6 +78,9 @@ RTC_API void rtcSetSceneProgressMonitorFunction(RTCScene scene, RTCProgressMonit
 /* Sets the build quality of the scene. */
 RTC_API void rtcSetSceneBuildQuality(RTCScene scene, enum RTCBuildQuality quality);
 
+/* Sets the ray footprint width as a factor of the distance to the ray origin, used to intersect small curves with less precision. */
+RTC_API void rtcSetSceneFootprintDistanceFactor(RTCScene scene, float factor);
+
 /* Sets the scene flags. */
 RTC_API void rtcSetSceneFlags(RTCScene scene, enum RTCSceneFlags flags);
 
@@ -82,6 +93,18 @@ RTC_API void rtcGetSceneBounds(RTCScene scene, struct RTCBounds* bounds_o);
 /* Returns the linear axis-aligned bounds of the scene. */
 RTC_API void rtcGetSceneLinearBounds(RTCScene scene, struct RTCLinearBounds* bounds_o);
 
+/* Traversal statistics of a scene */
+struct RTCSceneStatistics
+{
+  size_t nodeVisits;     // number of inner nodes visited per ray
+  size_t leafVisits;     // number of leaf nodes visited per ray
+  size_t primitiveTests; // number of primitives in leaves visited per ray
+  size_t filterCalls;    // number of filter function invocations
+};
+
+/* Returns the traversal statistics of the scene gathered since statistics got enabled. */
+RTC_API void rtcGetSceneStatistics(RTCScene scene, struct RTCSceneStatistics* stats_o);
+
 
 /* Perform a closest point query of the scene. */
 RTC_API bool rtcPointQuery(RTCScene scene, struct RTCPointQuery* query, struct RTCPointQueryContext* context, RTCPointQueryFunction queryFunc, void* userPtr);
@@ -119,6 +142,9 @@ RTC_API void rtcIntersectNM(RTCScene scene, struct RTCIntersectContext* context,
 /* Intersects a stream of M ray packets of size N in SOA format with the scene. */
 RTC_API void rtcIntersectNp(RTCScene scene, struct RTCIntersectContext* context, const struct RTCRayHitNp* rayhit, unsigned int N);
 
+/* Intersects a coherent tile of up to 16 ray packets of size 16 with the scene. */
+RTC_API void rtcIntersectTile(RTCScene scene, struct RTCIntersectContext* context, struct RTCRayHit16* rayhit, unsigned int M);
+
 /* Tests a single ray for occlusion with the scene. */
 RTC_API void rtcOccluded1(RTCScene scene, struct RTCIntersectContext* context, struct RTCRay* ray);
 
@@ -149,6 +175,42 @@ typedef void (*RTCCollideFunc) (void* userPtr, struct RTCCollision* collisions,
 
 /*! Performs collision detection of two scenes */
 RTC_API void rtcCollide (RTCScene scene0, RTCScene scene1, RTCCollideFunc callback, void* userPtr);
+
+/*! collision callback for scenes with instances */
+struct RTCCollisionInstanced
+{
+  unsigned int geomID0;
+  unsigned int primID0;
+  unsigned int geomID1;
+  unsigned int primID1;
+  unsigned int instID0[RTC_MAX_INSTANCE_LEVEL_COUNT]; // instance IDs of the first primitive
+  unsigned int instID1[RTC_MAX_INSTANCE_LEVEL_COUNT]; // instance IDs of the second primitive
+};
+typedef void (*RTCCollideInstancedFunc) (void* userPtr, struct RTCCollisionInstanced* collisions, unsigned int num_collisions);
+
+/*! Performs collision detection of two scenes, descending into instances */
+RTC_API void rtcCollideInstanced (RTCScene scene0, RTCScene scene1, RTCCollideInstancedFunc callback, void* userPtr);
+
+/* Ray queue type */
+typedef struct RTCRayQueueTy* RTCRayQueue;
+
+/* Callback receiving a batch of M intersected rays of a ray queue */
+typedef void (*RTCRayQueueFunction)(void* userPtr, struct RTCRayHit* rayhit, unsigned int M);
+
+/* Creates a new ray queue that traces enqueued rays through the scene and passes the hits to the callback. */
+RTC_API RTCRayQueue rtcNewRayQueue(RTCScene scene, enum RTCIntersectContextFlags flags, RTCRayQueueFunction callback, void* userPtr);
+
+/* Retains the ray queue (increments the reference count). */
+RTC_API void rtcRetainRayQueue(RTCRayQueue queue);
+
+/* Releases the ray queue (decrements the reference count). */
+RTC_API void rtcReleaseRayQueue(RTCRayQueue queue);
+
+/* Enqueues a stream of M rays into the ray queue, can get called by multiple threads concurrently. */
+RTC_API void rtcEnqueueRays(RTCRayQueue queue, const struct RTCRayHit* rayhit, unsigned int M, size_t byteStride);
+
+/* Traces all rays still contained in the ray queue. */
+RTC_API void rtcFlushRayQueue(RTCRayQueue queue);
  
 #if defined(__cplusplus)
 
@@ -14,6 +14,7 @@ namespace embree
     {
       static const size_t MAX_BRANCHING_FACTOR = 8;          //!< maximum supported BVH branching factor
       static const size_t MIN_LARGE_LEAF_LEVELS = 8;         //!< create balanced tree of we are that many levels before the maximum tree depth
+      static const size_t MAX_SAH_FALLBACK_SIZE = 4096;      //!< maximal number of primitives with identical morton codes we split using SAH
 
       /*! settings for morton builder */
       struct Settings
@@ -101,6 +102,48 @@ namespace embree
         }
       };
 
+      /*! Build primitive with 63 bit morton code, used to refine regions with identical 32 bit codes. */
+      struct __aligned(16) BuildPrim64
+      {
+        uint64_t code;         //!< morton code
+        unsigned int index;    //!< i'th primitive
+
+        /*! interface for radix sort */
+        __forceinline operator uint64_t() const { return code; }
+
+        /*! interface for standard sort */
+        __forceinline bool operator<(const BuildPrim64 &m) const { return code < m.code; }
+      };
+
+      /*! maps bounding box to 63 bit morton code */
+      struct MortonCodeMapping64
+      {
+        static const size_t LATTICE_BITS_PER_DIM = 21;
+        static const size_t LATTICE_SIZE_PER_DIM = size_t(1) << LATTICE_BITS_PER_DIM;
+
+        vfloat4 base;
+        vfloat4 scale;
+
+        __forceinline MortonCodeMapping64(const BBox3fa& bounds)
+        {
+          base  = (vfloat4)bounds.lower;
+          const vfloat4 diag  = (vfloat4)bounds.upper - (vfloat4)bounds.lower;
+          scale = select(diag > vfloat4(1E-19f), rcp(diag) * vfloat4(LATTICE_SIZE_PER_DIM * 0.99f),vfloat4(0.0f));
+        }
+
+        __forceinline uint64_t code (const BBox3fa& box) const
+        {
+          const vfloat4 lower = (vfloat4)box.lower;
+          const vfloat4 upper = (vfloat4)box.upper;
+          const vfloat4 centroid = lower+upper;
+          const vint4 binID = vint4((centroid-base)*scale);
+          const uint64_t x = (unsigned int) extract<0>(binID);
+          const uint64_t y = (unsigned int) extract<1>(binID);
+          const uint64_t z = (unsigned int) extract<2>(binID);
+          return bitInterleave64(x,y,z);
+        }
+      };
+
 #if defined (__AVX2__)
 
       /*! for AVX2 there is a fast scalar bitInterleave */
@@ -260,6 +303,29 @@ namespace embree
           return setBounds(node,bounds,numChildren);
         }
 
+        /*! calculates 63 bit morton codes relative to the centroid bounds of the range */
+        template<typename Mapping>
+        __forceinline void calculateMortonCodes64(const Mapping& mapping, const range<unsigned>& r, BuildPrim64* keys) const
+        {
+          for (size_t i=r.begin(); i<r.end(); i++) {
+            keys[i-r.begin()].code = mapping.code(calculateBounds(morton[i]));
+            keys[i-r.begin()].index = morton[i].index;
+          }
+        }
+
+        /*! stores sorted 63 bit codes back as 32 bit codes, the common prefix is
+         *  dropped such that the topmost differing bit ends up in bit 31 */
+        __forceinline void storeMortonCodes64(const BuildPrim64* keys, const range<unsigned>& current) const
+        {
+          const uint64_t diff = keys[0].code ^ keys[current.size()-1].code;
+          const size_t shift = diff ? 63-bsr(size_t(diff)) : 0;
+          for (size_t i=current.begin(); i<current.end(); i++) {
+            const BuildPrim64& key = keys[i-current.begin()];
+            morton[i].index = key.index;
+            morton[i].code = diff ? (unsigned int)((key.code << shift) >> 32) : 0;
+          }
+        }
+
         /*! recreates morton codes when reaching a region where all codes are identical */
         __noinline void recreateMortonCodes(const range<unsigned>& current) const
         {
@@ -271,13 +337,14 @@ namespace embree
             for (size_t i=current.begin(); i<current.end(); i++)
               centBounds.extend(center2(calculateBounds(morton[i])));
 
-            /* recalculate morton codes */
-            MortonCodeMapping mapping(centBounds);
-            for (size_t i=current.begin(); i<current.end(); i++)
-              morton[i].code = mapping.code(calculateBounds(morton[i]));
+            /* recalculate 63 bit morton codes */
+            BuildPrim64 keys[1024];
+            MortonCodeMapping64 mapping(centBounds);
+            calculateMortonCodes64(mapping,current,keys);
 
             /* sort morton codes */
-            std::sort(morton+current.begin(),morton+current.end());
+            std::sort(keys,keys+current.size());
+            storeMortonCodes64(keys,current);
           }
           else
           {
@@ -291,23 +358,67 @@ namespace embree
             const BBox3fa centBounds = parallel_reduce(current.begin(), current.end(), unsigned(1024),
                                                        BBox3fa(empty), calculateCentBounds, BBox3fa::merge);
 
-            /* recalculate morton codes */
-            MortonCodeMapping mapping(centBounds);
+            /* recalculate 63 bit morton codes */
+            avector<BuildPrim64> keys(current.size());
+            avector<BuildPrim64> tmp(current.size());
+            MortonCodeMapping64 mapping(centBounds);
             parallel_for(current.begin(), current.end(), unsigned(1024), [&] ( const range<unsigned>& r ) {
-                for (size_t i=r.begin(); i<r.end(); i++) {
-                  morton[i].code = mapping.code(calculateBounds(morton[i]));
-                }
+                calculateMortonCodes64(mapping,r,&keys[r.begin()-current.begin()]);
               });
 
             /*! sort morton codes */
-#if defined(TASKING_TBB)
-            tbb::parallel_sort(morton+current.begin(),morton+current.end());
-#else
-            radixsort32(morton+current.begin(),current.size());
-#endif
+            radix_sort_u64(keys.data(),tmp.data(),current.size(),singleThreadThreshold);
+            storeMortonCodes64(keys.data(),current);
           }
         }
 
+        /*! splits a range of primitives with identical morton codes using a SAH sweep over their size */
+        __noinline void splitSAH(const range<unsigned>& current, range<unsigned>& left, range<unsigned>& right) const
+        {
+          const size_t N = current.size();
+          if (N < 2 || N > MAX_SAH_FALLBACK_SIZE) {
+            current.split(left,right);
+            return;
+          }
+
+          /* the centroids are identical, thus sort primitives by surface area */
+          avector<std::pair<float,BuildPrim>> prims(N);
+          for (size_t i=0; i<N; i++) {
+            const BuildPrim& prim = morton[current.begin()+i];
+            prims[i] = std::make_pair(halfArea(calculateBounds(prim)),prim);
+          }
+          std::sort(prims.begin(),prims.end(),[] (const std::pair<float,BuildPrim>& a, const std::pair<float,BuildPrim>& b) {
+              return a.first < b.first;
+            });
+
+          /* sweep from the right to calculate bounds of all suffixes */
+          avector<BBox3fa> rbounds(N);
+          rbounds[N-1] = calculateBounds(prims[N-1].second);
+          for (size_t i=N-1; i>0; i--)
+            rbounds[i-1] = merge(rbounds[i],calculateBounds(prims[i-1].second));
+
+          /* sweep from the left to find best split */
+          BBox3fa lbounds = empty;
+          size_t bestSplit = N/2;
+          float bestCost = inf;
+          for (size_t i=1; i<N; i++)
+          {
+            lbounds.extend(calculateBounds(prims[i-1].second));
+            const float cost = halfArea(lbounds)*float(i) + halfArea(rbounds[i])*float(N-i);
+            if (cost < bestCost) {
+              bestCost = cost;
+              bestSplit = i;
+            }
+          }
+
+          for (size_t i=0; i<N; i++)
+            morton[current.begin()+i] = prims[i].second;
+
+          const unsigned center = current.begin()+(unsigned)bestSplit;
+          left = make_range(current.begin(),center);
+          right = make_range(center,current.end());
+        }
+
         __forceinline void split(const range<unsigned>& current, range<unsigned>& left, range<unsigned>& right) const
         {
           const unsigned int code_start = morton[current.begin()].code;
@@ -324,7 +435,7 @@ namespace embree
 
             /* if the morton code is still the same, goto fall back split */
             if (unlikely(bitpos == 32)) {
-              current.split(left,right);
+              splitSAH(current,left,right);
               return;
             }
           }
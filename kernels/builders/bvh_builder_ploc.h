@@ -0,0 +1,488 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "bvh_builder_morton.h"
+#include "priminfo.h"
+#include "../common/primref.h"
+#include "../../common/algorithms/parallel_for.h"
+#include "../../common/algorithms/parallel_sort.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! Parallel locally-ordered clustering (PLOC) builder. Primitives
+     *  are sorted along a Morton curve and then merged bottom-up with
+     *  their nearest neighbour inside a small search window. The
+     *  resulting binary tree is collapsed into an N-wide BVH using a
+     *  bottom-up SAH leaf decision. */
+    struct BVHBuilderPLOC
+    {
+      static const size_t MAX_BRANCHING_FACTOR = 8;          //!< maximum supported BVH branching factor
+      static const size_t MIN_LARGE_LEAF_LEVELS = 8;         //!< create balanced tree if we are that many levels before the maximum tree depth
+
+      /*! settings for PLOC builder */
+      struct Settings
+      {
+        /*! default settings */
+        Settings ()
+        : branchingFactor(2), maxDepth(32), logBlockSize(0), minLeafSize(1), maxLeafSize(7),
+          travCost(1.0f), intCost(1.0f), searchRadius(8), singleThreadThreshold(1024) {}
+
+        Settings (size_t sahBlockSize, size_t minLeafSize, size_t maxLeafSize, float travCost, float intCost, size_t searchRadius, size_t singleThreadThreshold)
+        : branchingFactor(2), maxDepth(32), logBlockSize(bsr(sahBlockSize)), minLeafSize(minLeafSize), maxLeafSize(maxLeafSize),
+          travCost(travCost), intCost(intCost), searchRadius(searchRadius), singleThreadThreshold(singleThreadThreshold)
+        {
+          this->minLeafSize = min(minLeafSize,maxLeafSize);
+        }
+
+      public:
+        size_t branchingFactor;  //!< branching factor of BVH to build
+        size_t maxDepth;         //!< maximum depth of BVH to build
+        size_t logBlockSize;     //!< log2 of blocksize for SAH heuristic
+        size_t minLeafSize;      //!< minimum size of a leaf
+        size_t maxLeafSize;      //!< maximum size of a leaf
+        float travCost;          //!< estimated cost of one traversal step
+        float intCost;           //!< estimated cost of one primitive intersection
+        size_t searchRadius;     //!< number of neighbouring clusters searched in each direction
+        size_t singleThreadThreshold; //!< threshold when we switch to single threaded build
+      };
+
+      /*! node of the temporary binary cluster tree */
+      struct __aligned(16) Cluster
+      {
+        BBox3fa bounds;      //!< bounds of all primitives of the cluster
+        unsigned int left;   //!< left child, or position in morton array for primitive clusters
+        unsigned int right;  //!< right child, or -1 for primitive clusters
+        unsigned int size;   //!< number of primitives in the cluster
+        float cost;          //!< SAH cost of the cluster subtree
+        bool leaf;           //!< true if the cluster becomes a leaf in the final BVH
+      };
+
+      template<
+        typename NodeRef,
+        typename Allocator,
+        typename CreateAllocFunc,
+        typename CreateNodeFunc,
+        typename SetNodeFunc,
+        typename CreateLeafFunc,
+        typename ProgressMonitor>
+
+        class BuilderT : private Settings
+      {
+        ALIGNED_CLASS_(16);
+
+        static const unsigned int INVALID = 0xFFFFFFFF;
+
+      public:
+
+        BuilderT (CreateAllocFunc& createAlloc,
+                  CreateNodeFunc& createNode,
+                  SetNodeFunc& setNode,
+                  CreateLeafFunc& createLeaf,
+                  ProgressMonitor& progressMonitor,
+                  const Settings& settings)
+
+          : Settings(settings),
+          createAlloc(createAlloc),
+          createNode(createNode),
+          setNode(setNode),
+          createLeaf(createLeaf),
+          progressMonitor(progressMonitor),
+          prims(nullptr) {}
+
+        /*! SAH cost of a leaf containing num primitives */
+        __forceinline float leafSAH(const BBox3fa& bounds, size_t num) const {
+          const size_t blocks = (num+(size_t(1)<<logBlockSize)-1) >> logBlockSize;
+          return intCost*halfArea(bounds)*float(blocks);
+        }
+
+        /*! merges two clusters into a new cluster and performs the bottom-up leaf decision */
+        __forceinline void mergeClusters(unsigned int dst, unsigned int left, unsigned int right)
+        {
+          const Cluster& l = clusters[left];
+          const Cluster& r = clusters[right];
+          Cluster& c = clusters[dst];
+          c.bounds = embree::merge(l.bounds,r.bounds);
+          c.left = left;
+          c.right = right;
+          c.size = l.size + r.size;
+
+          const float nodeCost = travCost*halfArea(c.bounds) + l.cost + r.cost;
+          const float leafCost = leafSAH(c.bounds,c.size);
+          c.leaf = c.size <= minLeafSize || (c.size <= maxLeafSize && leafCost <= nodeCost);
+          c.cost = c.leaf ? leafCost : nodeCost;
+        }
+
+        /*! the merge distance is symmetric in i and j, thus the globally closest pair is always a mutual pair */
+        __forceinline bool closer(float d0, unsigned int i, unsigned int j0, float d1, unsigned int j1) const
+        {
+          if (d0 != d1) return d0 < d1;
+          const unsigned int k0 = i > j0 ? i-j0 : j0-i;
+          const unsigned int k1 = i > j1 ? i-j1 : j1-i;
+          if (k0 != k1) return k0 < k1;
+          /* for identical distances prefer pairs (2k,2k+1) to keep merging in parallel */
+          return (min(i,j0) & 1) < (min(i,j1) & 1);
+        }
+
+        /*! searches for each cluster the closest cluster inside the search window */
+        void findNearestNeighbours(const unsigned int* C, unsigned int* nn, unsigned int numClusters)
+        {
+          const unsigned int radius = max(1u,(unsigned int) searchRadius);
+          parallel_for(0u, numClusters, 1024u, [&] (const range<unsigned int>& r)
+          {
+            for (unsigned int i=r.begin(); i<r.end(); i++)
+            {
+              const BBox3fa bi = clusters[C[i]].bounds;
+              const unsigned int jbegin = i > radius ? i-radius : 0;
+              const unsigned int jend = min(i+radius+1,numClusters);
+
+              float bestDist = pos_inf;
+              unsigned int bestID = INVALID;
+              for (unsigned int j=jbegin; j<jend; j++)
+              {
+                if (j == i) continue;
+                const float d = halfArea(embree::merge(bi,clusters[C[j]].bounds));
+                if (bestID == INVALID || closer(d,i,j,bestDist,bestID)) {
+                  bestDist = d;
+                  bestID = j;
+                }
+              }
+              nn[i] = bestID;
+            }
+          });
+        }
+
+        /*! merges all mutual nearest neighbours and compacts the cluster list preserving the morton order */
+        unsigned int mergeNearestNeighbours(unsigned int* C, unsigned int* Cnext, const unsigned int* nn, unsigned int numClusters)
+        {
+          enum { MAX_TASKS = 64 };
+          const unsigned int blockSize = 1024;
+          const unsigned int numBlocks = (numClusters+blockSize-1)/blockSize;
+          const unsigned int numTasks = min((unsigned int)TaskScheduler::threadCount(),numBlocks,(unsigned int)MAX_TASKS);
+
+          /* merge mutual pairs, the cluster with the smaller index owns the merged cluster */
+          unsigned int counts[MAX_TASKS];
+          parallel_for(numTasks, [&](const unsigned int taskIndex)
+          {
+            const unsigned int i0 = (unsigned int)((size_t(taskIndex)+0)*numClusters/numTasks);
+            const unsigned int i1 = (unsigned int)((size_t(taskIndex)+1)*numClusters/numTasks);
+            unsigned int count = 0;
+            for (unsigned int i=i0; i<i1; i++)
+            {
+              const unsigned int j = nn[i];
+              if (nn[j] == i) {
+                if (i > j) continue;
+                const unsigned int c = nextCluster.fetch_add(1);
+                mergeClusters(c,C[i],C[j]);
+                C[i] = c;
+              }
+              count++;
+            }
+            counts[taskIndex] = count;
+          });
+
+          /* calculate output offsets */
+          unsigned int offsets[MAX_TASKS];
+          unsigned int numNext = 0;
+          for (unsigned int i=0; i<numTasks; i++) {
+            offsets[i] = numNext;
+            numNext += counts[i];
+          }
+
+          /* stable compaction of the cluster list */
+          parallel_for(numTasks, [&](const unsigned int taskIndex)
+          {
+            const unsigned int i0 = (unsigned int)((size_t(taskIndex)+0)*numClusters/numTasks);
+            const unsigned int i1 = (unsigned int)((size_t(taskIndex)+1)*numClusters/numTasks);
+            unsigned int dst = offsets[taskIndex];
+            for (unsigned int i=i0; i<i1; i++)
+            {
+              const unsigned int j = nn[i];
+              if (nn[j] == i && i > j) continue;
+              Cnext[dst++] = C[i];
+            }
+          });
+
+          assert(numNext < numClusters);
+          return numNext;
+        }
+
+        /*! copies all primitives of a cluster to the output array in tree order */
+        void gatherPrimitives(unsigned int cluster, size_t begin)
+        {
+          /* the stack never holds more entries than the cluster has primitives */
+          unsigned int stack_local[64];
+          avector<unsigned int> stack_heap;
+          unsigned int* stack = stack_local;
+          if (clusters[cluster].size > 64) {
+            stack_heap.resize(clusters[cluster].size);
+            stack = stack_heap.data();
+          }
+
+          size_t sp = 0;
+          stack[sp++] = cluster;
+          while (sp)
+          {
+            const Cluster& c = clusters[stack[--sp]];
+            if (c.right == INVALID) {
+              prims[begin++] = src[morton[c.left].index];
+              continue;
+            }
+            stack[sp++] = c.right;
+            stack[sp++] = c.left;
+          }
+        }
+
+        /*! creates a balanced tree over a range of primitives when we are close to the maximum depth */
+        NodeRef createLargeLeaf(size_t depth, const range<size_t>& current, Allocator alloc)
+        {
+          /* this should never occur but is a fatal error */
+          if (depth > maxDepth)
+            throw_RTCError(RTC_ERROR_UNKNOWN,"depth limit reached");
+
+          /* create leaf for few primitives */
+          if (current.size() <= maxLeafSize)
+            return createLeaf(prims,current,alloc);
+
+          /* fill all children by always splitting the largest one */
+          range<size_t> children[MAX_BRANCHING_FACTOR];
+          size_t numChildren = 1;
+          children[0] = current;
+
+          do {
+            size_t bestChild = -1;
+            size_t bestSize = 0;
+            for (size_t i=0; i<numChildren; i++)
+            {
+              if (children[i].size() <= maxLeafSize)
+                continue;
+
+              if (children[i].size() > bestSize) {
+                bestSize = children[i].size();
+                bestChild = i;
+              }
+            }
+            if (bestChild == size_t(-1)) break;
+
+            auto split = children[bestChild].split();
+            children[bestChild] = children[numChildren-1];
+            children[numChildren-1] = split.first;
+            children[numChildren+0] = split.second;
+            numChildren++;
+
+          } while (numChildren < branchingFactor);
+
+          NodeRef node = createNode(alloc,numChildren);
+          for (size_t i=0; i<numChildren; i++)
+          {
+            BBox3fa bounds = empty;
+            for (size_t j=children[i].begin(); j<children[i].end(); j++)
+              bounds.extend(prims[j].bounds());
+            setNode(node,i,createLargeLeaf(depth+1,children[i],alloc),bounds);
+          }
+          return node;
+        }
+
+        /*! collapses the binary cluster tree into an N-wide BVH */
+        NodeRef recurse(size_t depth, unsigned int cluster, size_t begin, Allocator alloc, bool toplevel)
+        {
+          /* get thread local allocator */
+          if (!alloc)
+            alloc = createAlloc();
+
+          const Cluster& current = clusters[cluster];
+
+          /* call memory monitor function to signal progress */
+          if (toplevel && current.size <= singleThreadThreshold)
+            progressMonitor(current.size);
+
+          /* create leaf node */
+          if (current.leaf || depth+MIN_LARGE_LEAF_LEVELS >= maxDepth)
+          {
+            gatherPrimitives(cluster,begin);
+            const range<size_t> r(begin,begin+current.size);
+            if (current.leaf) return createLeaf(prims,r,alloc);
+            else              return createLargeLeaf(depth,r,alloc);
+          }
+
+          /* fill all children by always opening the one with the largest surface area */
+          unsigned int children[MAX_BRANCHING_FACTOR];
+          children[0] = current.left;
+          children[1] = current.right;
+          size_t numChildren = 2;
+
+          while (numChildren < branchingFactor)
+          {
+            int bestChild = -1;
+            float bestArea = neg_inf;
+            for (size_t i=0; i<numChildren; i++)
+            {
+              /* ignore leaves as they cannot get opened */
+              const Cluster& c = clusters[children[i]];
+              if (c.leaf) continue;
+
+              const float A = halfArea(c.bounds);
+              if (A > bestArea) {
+                bestArea = A;
+                bestChild = (int)i;
+              }
+            }
+            if (bestChild == -1) break;
+
+            /* keep the children in tree order to keep primitives of a subtree continuous */
+            const Cluster& c = clusters[children[bestChild]];
+            for (size_t i=numChildren; i>size_t(bestChild)+1; i--)
+              children[i] = children[i-1];
+            children[bestChild+0] = c.left;
+            children[bestChild+1] = c.right;
+            numChildren++;
+          }
+
+          /* allocate node */
+          NodeRef node = createNode(alloc,numChildren);
+
+          size_t offsets[MAX_BRANCHING_FACTOR];
+          for (size_t i=0, offset=begin; i<numChildren; i++) {
+            offsets[i] = offset;
+            offset += clusters[children[i]].size;
+          }
+
+          /* process top parts of tree parallel */
+          NodeRef refs[MAX_BRANCHING_FACTOR];
+          if (current.size > singleThreadThreshold)
+          {
+            parallel_for(size_t(0), numChildren, [&] (const range<size_t>& r) {
+                for (size_t i=r.begin(); i<r.end(); i++) {
+                  refs[i] = recurse(depth+1,children[i],offsets[i],nullptr,true);
+                  _mm_mfence(); // to allow non-temporal stores during build
+                }
+              });
+          }
+
+          /* finish tree sequentially */
+          else
+          {
+            for (size_t i=0; i<numChildren; i++)
+              refs[i] = recurse(depth+1,children[i],offsets[i],alloc,false);
+          }
+
+          for (size_t i=0; i<numChildren; i++)
+            setNode(node,i,refs[i],clusters[children[i]].bounds);
+
+          return node;
+        }
+
+        /* build function */
+        NodeRef build(PrimRef* src_in, PrimRef* dst_in, const PrimInfo& pinfo)
+        {
+          const unsigned int numPrimitives = (unsigned int) pinfo.size();
+          src = src_in;
+          prims = dst_in;
+
+          /* compute and sort morton codes */
+          morton.resize(numPrimitives);
+          avector<BVHBuilderMorton::BuildPrim> morton_tmp(numPrimitives);
+          const BVHBuilderMorton::MortonCodeMapping mapping(pinfo.centBounds);
+          parallel_for(0u, numPrimitives, 1024u, [&] (const range<unsigned int>& r) {
+              for (unsigned int i=r.begin(); i<r.end(); i++) {
+                morton[i].index = i;
+                morton[i].code = mapping.code(src[i].bounds());
+              }
+            });
+          radix_sort_u32(morton.data(),morton_tmp.data(),numPrimitives,singleThreadThreshold);
+
+          /* create one cluster per primitive */
+          clusters.resize(2*numPrimitives-1);
+          avector<unsigned int> clusterList0(numPrimitives), clusterList1(numPrimitives), nn(numPrimitives);
+          unsigned int* C = clusterList0.data();
+          unsigned int* Cnext = clusterList1.data();
+          parallel_for(0u, numPrimitives, 1024u, [&] (const range<unsigned int>& r) {
+              for (unsigned int i=r.begin(); i<r.end(); i++)
+              {
+                Cluster& c = clusters[i];
+                c.bounds = src[morton[i].index].bounds();
+                c.left = i;
+                c.right = INVALID;
+                c.size = 1;
+                c.cost = leafSAH(c.bounds,1);
+                c.leaf = true;
+                C[i] = i;
+              }
+            });
+
+          /* merge clusters until a single cluster remains */
+          nextCluster.store(numPrimitives);
+          unsigned int numClusters = numPrimitives;
+          while (numClusters > 1)
+          {
+            findNearestNeighbours(C,nn.data(),numClusters);
+            numClusters = mergeNearestNeighbours(C,Cnext,nn.data(),numClusters);
+            std::swap(C,Cnext);
+          }
+
+          /* collapse binary tree into BVH */
+          const NodeRef root = recurse(1,C[0],0,nullptr,true);
+          _mm_mfence(); // to allow non-temporal stores during build
+          return root;
+        }
+
+      private:
+        CreateAllocFunc& createAlloc;
+        CreateNodeFunc& createNode;
+        SetNodeFunc& setNode;
+        CreateLeafFunc& createLeaf;
+        ProgressMonitor& progressMonitor;
+
+      private:
+        PrimRef* src;
+        PrimRef* prims;
+        avector<BVHBuilderMorton::BuildPrim> morton;
+        avector<Cluster> clusters;
+        std::atomic<unsigned int> nextCluster;
+      };
+
+      /*! builds a BVH over the primitive references in prims, the
+       *  primitives get reordered into dst which is passed to the leaf
+       *  creation function */
+      template<
+        typename NodeRef,
+        typename CreateAllocFunc,
+        typename CreateNodeFunc,
+        typename SetNodeFunc,
+        typename CreateLeafFunc,
+        typename ProgressMonitor>
+
+        static NodeRef build(CreateAllocFunc createAlloc,
+                             CreateNodeFunc createNode,
+                             SetNodeFunc setNode,
+                             CreateLeafFunc createLeaf,
+                             ProgressMonitor progressMonitor,
+                             PrimRef* prims,
+                             PrimRef* dst,
+                             const PrimInfo& pinfo,
+                             const Settings& settings)
+        {
+          typedef BuilderT<
+            NodeRef,
+            decltype(createAlloc()),
+            CreateAllocFunc,
+            CreateNodeFunc,
+            SetNodeFunc,
+            CreateLeafFunc,
+            ProgressMonitor> Builder;
+
+          Builder builder(createAlloc,
+                          createNode,
+                          setNode,
+                          createLeaf,
+                          progressMonitor,
+                          settings);
+
+          return builder.build(prims,dst,pinfo);
+        }
+    };
+  }
+}
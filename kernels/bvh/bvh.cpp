@@ -17,8 +17,6 @@ namespace embree
   template<int N>
   BVHN<N>::~BVHN ()
   {
-    for (size_t i=0; i<objects.size(); i++) 
-      delete objects[i];
   }
 
   template<int N>
@@ -26,6 +24,18 @@ namespace embree
   {
     set(BVHN::emptyNode,empty,0);
     alloc.clear();
+
+    /* per geometry BVHs might be shared with other scenes, thus we only drop our references */
+    objects.clear();
+  }
+
+  template<int N>
+  size_t BVHN<N>::bytesAllocated()
+  {
+    size_t bytes = alloc.getStatistics(FastAllocator::ANY_TYPE).bytesAllocatedTotal();
+    for (size_t i=0; i<objects.size(); i++)
+      if (objects[i]) bytes += objects[i]->bytesAllocated();
+    return bytes;
   }
 
   template<int N>
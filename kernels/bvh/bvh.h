@@ -96,6 +96,9 @@ namespace embree
     
     /*! clears the acceleration structure */
     void clear();
+
+    /*! returns the bytes allocated for the nodes and leaves, including the per geometry BVHs */
+    size_t bytesAllocated();
     
     /*! sets BVH members after build */
     void set (NodeRef root, const LBBox3fa& bounds, size_t numPrimitives);
@@ -226,7 +229,7 @@ namespace embree
     
     /*! data arrays for special builders */
   public:
-    std::vector<BVHN*> objects;
+    std::vector<Ref<BVHN>> objects;   //!< per geometry BVHs of the two level builder, possibly shared with other scenes
     vector_t<char,aligned_allocator<char,32>> subdiv_patches;
   };
   
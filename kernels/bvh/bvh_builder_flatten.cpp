@@ -0,0 +1,177 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "bvh.h"
+#include "bvh_builder.h"
+#include "../geometry/trianglef.h"
+
+#include <algorithm>
+
+namespace embree
+{
+  namespace isa
+  {
+    /* Builds a BVH over the triangles of all flattened instances of a
+     * scene. The triangles get transformed into the space of the scene
+     * such that rays hit them without traversing the instanced scene. */
+    template<int N>
+    struct BVHNFlattenedInstanceBuilderSAH : public Builder
+    {
+      typedef BVHN<N> BVH;
+      typedef typename BVH::NodeRef NodeRef;
+      typedef FastAllocator::CachedAllocator Allocator;
+
+      static const size_t maxLeafSize = 8; //!< also bounds the number of blocks of a leaf as each block stores triangles of a single instance
+
+      BVH* bvh;
+      Scene* scene;
+      mvector<PrimRef> prims;
+      GeneralBVHBuilder::Settings settings;
+
+      BVHNFlattenedInstanceBuilderSAH (BVH* bvh, Scene* scene)
+        : bvh(bvh), scene(scene), prims(scene->device,0),
+          settings(Triangle4f::max_size(), 1, maxLeafSize, travCost, 1.0f, DEFAULT_SINGLE_THREAD_THRESHOLD) {}
+
+      /*! creates primrefs for all triangles of all flattened instances,
+       *  the primitive ID indexes the triangles of the instanced scene */
+      PrimInfo createPrimRefArray()
+      {
+        /* count triangles of flattened instances */
+        std::vector<unsigned int> instances;
+        std::vector<size_t> offsets;
+        size_t numPrimitives = 0;
+        for (size_t i=0; i<scene->size(); i++)
+        {
+          Geometry* geom = scene->get(i);
+          if (geom == nullptr || !geom->isEnabled() || geom->getType() != Geometry::GTY_INSTANCE_CHEAP) continue;
+          Instance* instance = (Instance*) geom;
+          if (!instance->isFlattened()) continue;
+          instances.push_back(unsigned(i));
+          offsets.push_back(numPrimitives);
+          numPrimitives += ((Scene*)instance->object)->numPrimitives();
+        }
+        if (numPrimitives == 0)
+          return PrimInfo(empty);
+
+        prims.resize(numPrimitives);
+        std::vector<size_t> counts(instances.size());
+        PrimInfo pinfo = parallel_reduce(size_t(0), instances.size(), size_t(64), PrimInfo(empty), [&](const range<size_t>& r) -> PrimInfo
+        {
+          PrimInfo pinfo(empty);
+          for (size_t j=r.begin(); j<r.end(); j++)
+          {
+            const unsigned int instID = instances[j];
+            const Instance* instance = scene->get<Instance>(instID);
+            const Scene* object = (const Scene*) instance->object;
+            const AffineSpace3fa local2world = instance->getLocal2World();
+
+            size_t k = offsets[j];
+            unsigned int index = 0;
+            for (size_t g=0; g<object->size(); g++)
+            {
+              const Geometry* geom = object->get(g);
+              if (geom == nullptr || !geom->isEnabled() || geom->getType() != Geometry::GTY_TRIANGLE_MESH) continue;
+              const TriangleMesh* mesh = (const TriangleMesh*) geom;
+              for (size_t p=0; p<mesh->size(); p++, index++)
+              {
+                if (!mesh->buildBounds(p)) continue;
+                const TriangleMesh::Triangle& tri = mesh->triangle(p);
+                BBox3fa bounds = empty;
+                bounds.extend(xfmPoint(local2world,mesh->vertex(tri.v[0])));
+                bounds.extend(xfmPoint(local2world,mesh->vertex(tri.v[1])));
+                bounds.extend(xfmPoint(local2world,mesh->vertex(tri.v[2])));
+                if (!isvalid(bounds)) continue;
+                const PrimRef prim(bounds,instID,index);
+                pinfo.add_center2(prim);
+                prims[k++] = prim;
+              }
+            }
+            counts[j] = k-offsets[j];
+          }
+          return pinfo;
+        }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
+
+        /* remove gaps left by invalid triangles */
+        size_t numValid = 0;
+        for (size_t j=0; j<instances.size(); j++) {
+          if (numValid != offsets[j])
+            std::copy(&prims[offsets[j]],&prims[offsets[j]]+counts[j],&prims[numValid]);
+          numValid += counts[j];
+        }
+        assert(numValid == pinfo.size());
+        return pinfo;
+      }
+
+      /*! creates a leaf, triangles of different instances are stored in different blocks */
+      NodeRef createLeaf(const PrimRef* prims_i, const range<size_t>& set, const Allocator& alloc) const
+      {
+        const size_t n = set.size();
+        assert(n <= maxLeafSize);
+
+        PrimRef prims[maxLeafSize];
+        for (size_t i=0; i<n; i++) prims[i] = prims_i[set.begin()+i];
+        std::sort(prims,prims+n,[] (const PrimRef& a, const PrimRef& b) { return a.geomID() < b.geomID(); });
+
+        size_t items = 0;
+        for (size_t i=0; i<n; ) {
+          size_t j = i+1;
+          while (j<n && prims[j].geomID() == prims[i].geomID()) j++;
+          items += Triangle4f::blocks(j-i);
+          i = j;
+        }
+
+        Triangle4f* accel = (Triangle4f*) alloc.malloc1(items*sizeof(Triangle4f),BVH::byteAlignment);
+        size_t begin = 0;
+        for (size_t i=0; i<items; i++)
+          accel[i].fill(prims,begin,n,scene);
+        assert(begin == n);
+        return BVH::encodeLeaf((char*)accel,items);
+      }
+
+      void build()
+      {
+        double t0 = bvh->preBuild(TOSTRING(isa) "::BVH" + toString(N) + "FlattenedInstanceBuilderSAH");
+
+        /* create primref array */
+        PrimInfo pinfo = createPrimRefArray();
+
+        /* skip build if no instance got flattened */
+        if (pinfo.size() == 0)
+        {
+          bvh->clear();
+          prims.clear();
+          bvh->postBuild(t0);
+          return;
+        }
+
+        /* initialize allocator */
+        const size_t node_bytes = pinfo.size()*sizeof(typename BVH::AABBNode)/(4*N);
+        const size_t leaf_bytes = size_t(1.2*Triangle4f::blocks(pinfo.size())*sizeof(Triangle4f));
+        bvh->alloc.init_estimate(node_bytes+leaf_bytes);
+        settings.singleThreadThreshold = bvh->alloc.fixSingleThreadThreshold(N,DEFAULT_SINGLE_THREAD_THRESHOLD,pinfo.size(),node_bytes+leaf_bytes);
+
+        /* call BVH builder */
+        auto createLeafFunc = [&] (const PrimRef* prims, const range<size_t>& set, const Allocator& alloc) -> NodeRef {
+          return createLeaf(prims,set,alloc);
+        };
+        NodeRef root = BVHNBuilderVirtual<N>::build(&bvh->alloc,createLeafFunc,scene->progressInterface,prims.data(),pinfo,settings);
+        bvh->set(root,LBBox3fa(pinfo.geomBounds),pinfo.size());
+        bvh->layoutLargeNodes(size_t(pinfo.size()*0.005f));
+
+        /* clear temporary data for static geometry */
+        if (scene->isStaticAccel()) {
+          prims.clear();
+        }
+        bvh->cleanup();
+        bvh->postBuild(t0);
+      }
+
+      void clear() {
+        prims.clear();
+      }
+    };
+
+    /*! entry functions for the builder */
+    Builder* BVH4Triangle4fSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNFlattenedInstanceBuilderSAH<4>((BVH4*)bvh,scene); }
+  }
+}
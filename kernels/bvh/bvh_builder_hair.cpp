@@ -8,6 +8,9 @@
 #include "../geometry/linei.h"
 #include "../geometry/curveNi.h"
 #include "../geometry/curveNv.h"
+#include "../geometry/curveNq.h"
+#include "../geometry/triangle.h"
+#include "../geometry/quadv.h"
 
 #if defined(EMBREE_GEOMETRY_CURVE) || defined(EMBREE_GEOMETRY_POINT)
 
@@ -120,6 +123,7 @@ namespace embree
     /*! entry functions for the builder */
     Builder* BVH4Curve4vBuilder_OBB_New   (void* bvh, Scene* scene, size_t mode) { return new BVHNHairBuilderSAH<4,Curve4v,Line4i,Point4i>((BVH4*)bvh,scene); }
     Builder* BVH4Curve4iBuilder_OBB_New   (void* bvh, Scene* scene, size_t mode) { return new BVHNHairBuilderSAH<4,Curve4i,Line4i,Point4i>((BVH4*)bvh,scene); }
+    Builder* BVH4Curve4qBuilder_OBB_New   (void* bvh, Scene* scene, size_t mode) { return new BVHNHairBuilderSAH<4,Curve4q,Line4i,Point4i>((BVH4*)bvh,scene); }
 
 #if defined(__AVX__)
     Builder* BVH8Curve8vBuilder_OBB_New   (void* bvh, Scene* scene, size_t mode) { return new BVHNHairBuilderSAH<8,Curve8v,Line8i,Point8i>((BVH8*)bvh,scene); }
@@ -129,3 +133,126 @@ namespace embree
   }
 }
 #endif
+
+#if defined(EMBREE_GEOMETRY_TRIANGLE) || defined(EMBREE_GEOMETRY_QUAD)
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! Builds mixed AABB/OBB hierarchies over thin triangles or quads,
+     *  e.g. foliage and cables. Subtrees whose primitives share a
+     *  dominant direction get oriented nodes, like for hair. */
+    template<int N, typename Primitive>
+    struct BVHNOBBBuilderSAH : public Builder
+    {
+      typedef BVHN<N> BVH;
+      typedef typename BVH::NodeRef NodeRef;
+
+      BVH* bvh;
+      Scene* scene;
+      mvector<PrimRef> prims;
+      BVHBuilderHair::Settings settings;
+      Geometry::GTypeMask gtype_;
+
+      BVHNOBBBuilderSAH (BVH* bvh, Scene* scene, Geometry::GTypeMask gtype)
+        : bvh(bvh), scene(scene), prims(scene->device,0), gtype_(gtype) {}
+
+      void build()
+      {
+        /* if we use the primrefarray for allocations we have to take it back from the BVH */
+        if (settings.finished_range_threshold != size_t(inf))
+          bvh->alloc.unshare(prims);
+
+        /* fast path for empty BVH */
+        const size_t numPrimitives = scene->getNumPrimitives(gtype_,false);
+        if (numPrimitives == 0) {
+          bvh->clear();
+          prims.clear();
+          return;
+        }
+
+        double t0 = bvh->preBuild(TOSTRING(isa) "::BVH" + toString(N) + "OBBBuilderSAH");
+
+        /* create primref array */
+        prims.resize(numPrimitives);
+        const PrimInfo pinfo = createPrimRefArray(scene,gtype_,false,numPrimitives,prims,scene->progressInterface);
+
+        /* estimate acceleration structure size */
+        const size_t node_bytes = pinfo.size()*sizeof(typename BVH::OBBNode)/(4*N);
+        const size_t leaf_bytes = size_t(1.2*Primitive::blocks(pinfo.size())*sizeof(Primitive));
+        bvh->alloc.init_estimate(node_bytes+leaf_bytes);
+
+        /* builder settings */
+        settings.branchingFactor = N;
+        settings.maxDepth = BVH::maxBuildDepthLeaf;
+        settings.logBlockSize = bsf(Primitive::max_size());
+        settings.minLeafSize = Primitive::max_size();
+        settings.maxLeafSize = Primitive::max_size();
+        settings.finished_range_threshold = numPrimitives/1000;
+        if (settings.finished_range_threshold < 1000)
+          settings.finished_range_threshold = inf;
+
+        /* creates a leaf node */
+        auto createLeaf = [&] (const PrimRef* prims, const range<size_t>& set, const FastAllocator::CachedAllocator& alloc) -> NodeRef {
+
+          if (set.size() == 0)
+            return BVH::emptyNode;
+
+          const size_t items = Primitive::blocks(set.size());
+          size_t start = set.begin();
+          Primitive* accel = (Primitive*) alloc.malloc1(items*sizeof(Primitive),BVH::byteAlignment);
+          NodeRef node = BVH::encodeLeaf((char*)accel,items);
+          for (size_t i=0; i<items; i++)
+            accel[i].fill(prims,start,set.end(),bvh->scene);
+          return node;
+        };
+
+        auto reportFinishedRange = [&] (const range<size_t>& range) -> void
+          {
+            PrimRef* begin = prims.data()+range.begin();
+            PrimRef* end   = prims.data()+range.end();
+            size_t bytes = (size_t)end - (size_t)begin;
+            bvh->alloc.addBlock(begin,bytes);
+          };
+
+        /* build hierarchy */
+        typename BVH::NodeRef root = BVHBuilderHair::build<NodeRef>
+          (typename BVH::CreateAlloc(bvh),
+           typename BVH::AABBNode::Create(),
+           typename BVH::AABBNode::Set(),
+           typename BVH::OBBNode::Create(),
+           typename BVH::OBBNode::Set(),
+           createLeaf,scene->progressInterface,
+           reportFinishedRange,
+           scene,prims.data(),pinfo,settings);
+
+        bvh->set(root,LBBox3fa(pinfo.geomBounds),pinfo.size());
+
+        /* if we allocated using the primrefarray we have to keep it alive */
+        if (settings.finished_range_threshold != size_t(inf))
+          bvh->alloc.share(prims);
+
+        /* clear temporary data for static geometry */
+        if (scene->isStaticAccel()) {
+          prims.clear();
+        }
+        bvh->cleanup();
+        bvh->postBuild(t0);
+      }
+
+      void clear() {
+        prims.clear();
+      }
+    };
+
+    /*! entry functions for the builder */
+#if defined(EMBREE_GEOMETRY_TRIANGLE)
+    Builder* BVH4Triangle4SceneBuilderOBB (void* bvh, Scene* scene, size_t mode) { return new BVHNOBBBuilderSAH<4,Triangle4>((BVH4*)bvh,scene,TriangleMesh::geom_type); }
+#endif
+#if defined(EMBREE_GEOMETRY_QUAD)
+    Builder* BVH4Quad4vSceneBuilderOBB    (void* bvh, Scene* scene, size_t mode) { return new BVHNOBBBuilderSAH<4,Quad4v>((BVH4*)bvh,scene,QuadMesh::geom_type); }
+#endif
+  }
+}
+#endif
@@ -0,0 +1,197 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "bvh.h"
+#include "bvh_builder.h"
+#include "../builders/primrefgen.h"
+
+#include "../geometry/mixed.h"
+#include "../geometry/triangle.h"
+#include "../geometry/quadv.h"
+#include "../geometry/curveNv.h"
+#include "../geometry/linei.h"
+#include "../geometry/pointi.h"
+#include "../geometry/object.h"
+#include "../geometry/instance.h"
+
+#include <algorithm>
+
+namespace embree
+{
+  namespace isa
+  {
+    /* Builds a single BVH over all static triangles, quads, curves,
+     * user geometries, and instances of a scene. Leaves are typed such
+     * that traversal visits all primitive types in a single front to
+     * back pass instead of traversing one BVH per primitive type. */
+    template<int N>
+    struct BVHNMixedBuilderSAH : public Builder
+    {
+      typedef BVHN<N> BVH;
+      typedef typename BVH::NodeRef NodeRef;
+      typedef typename BVH::AABBNode AABBNode;
+      typedef FastAllocator::CachedAllocator Allocator;
+
+      BVH* bvh;
+      Scene* scene;
+      mvector<PrimRef> prims;
+      GeneralBVHBuilder::Settings settings;
+
+      static const Geometry::GTypeMask gtype = Geometry::GTypeMask(Geometry::MTY_TRIANGLE_MESH | Geometry::MTY_QUAD_MESH | Geometry::MTY_CURVES |
+                                                                   Geometry::MTY_USER_GEOMETRY | Geometry::MTY_INSTANCE);
+
+      BVHNMixedBuilderSAH (BVH* bvh, Scene* scene)
+        : bvh(bvh), scene(scene), prims(scene->device,0),
+          settings(4, 1, N, travCost, 1.0f, DEFAULT_SINGLE_THREAD_THRESHOLD) {}
+
+      /*! returns the type of leaf a primitive gets stored in */
+      __forceinline size_t leafType(const PrimRef& prim) const
+      {
+        const Geometry::GTypeMask mask = scene->get(prim.geomID())->getTypeMask();
+        if      (mask & Geometry::MTY_TRIANGLE_MESH) return MixedPrimitive::TY_TRIANGLE4;
+        else if (mask & Geometry::MTY_QUAD_MESH    ) return MixedPrimitive::TY_QUAD4V;
+        else if (mask & Geometry::MTY_CURVES       ) return MixedPrimitive::TY_CURVE;
+        else if (mask & Geometry::MTY_USER_GEOMETRY) return MixedPrimitive::TY_OBJECT;
+        else                                         return MixedPrimitive::TY_INSTANCE;
+      }
+
+      /*! creates a typed leaf holding a single primitive block */
+      template<typename Primitive>
+      __forceinline NodeRef createBlock(size_t ty, const PrimRef* prims, const range<size_t>& set, const Allocator& alloc) const
+      {
+        size_t start = set.begin();
+        Primitive* accel = (Primitive*) alloc.malloc1(sizeof(Primitive),BVH::byteAlignment);
+        accel->fill(prims,start,set.end(),scene);
+        return BVH::encodeTypedLeaf(accel,ty);
+      }
+
+      /*! creates a typed leaf for primitives of the same leaf type */
+      NodeRef createTypedLeaf(size_t ty, const PrimRef* prims, const range<size_t>& set, const Allocator& alloc) const
+      {
+        switch (ty) {
+        case MixedPrimitive::TY_TRIANGLE4: return createBlock<Triangle4>(ty,prims,set,alloc);
+        case MixedPrimitive::TY_QUAD4V   : return createBlock<Quad4v>(ty,prims,set,alloc);
+        case MixedPrimitive::TY_OBJECT   : return createBlock<Object>(ty,prims,set,alloc);
+        case MixedPrimitive::TY_INSTANCE : return createBlock<InstancePrimitive>(ty,prims,set,alloc);
+        case MixedPrimitive::TY_CURVE    :
+        {
+          /* curve leaves are dispatched through the virtual curve intersector */
+          NodeRef ref;
+          Geometry* geom = scene->get(prims[set.begin()].geomID());
+          if (geom->getTypeMask() & Geometry::MTY_POINTS)
+            ref = Point4i::createLeaf(bvh,prims,set,alloc);
+          else if (geom->getCurveBasis() == Geometry::GTY_BASIS_LINEAR)
+            ref = Line4i::createLeaf(bvh,prims,set,alloc);
+          else
+            ref = Curve4v::createLeaf(bvh,prims,set,alloc);
+          size_t num; char* ptr = ref.leaf(num);
+          assert(num == 1);
+          return BVH::encodeTypedLeaf(ptr,ty);
+        }
+        default: assert(false); return BVH::emptyNode;
+        }
+      }
+
+      /*! creates one typed leaf per primitive type of the range, multiple
+       *  leaves get combined using an additional node */
+      NodeRef createLeaf(const PrimRef* prims_i, const range<size_t>& set, const Allocator& alloc) const
+      {
+        const size_t n = set.size();
+        assert(n <= N);
+
+        /* group primitives by leaf type and geometry */
+        PrimRef prims[N];
+        for (size_t i=0; i<n; i++) prims[i] = prims_i[set.begin()+i];
+        std::sort(prims,prims+n,[&] (const PrimRef& a, const PrimRef& b) {
+            const size_t tya = leafType(a), tyb = leafType(b);
+            return tya < tyb || (tya == tyb && a.geomID() < b.geomID());
+          });
+
+        NodeRef children[N];
+        BBox3fa bounds[N];
+        size_t numChildren = 0;
+        for (size_t i=0; i<n; )
+        {
+          /* triangles and quads of different geometries share a block,
+           * curves of one geometry share a block, all other primitives
+           * get stored separately */
+          const size_t ty = leafType(prims[i]);
+          size_t j = i+1;
+          if (ty == MixedPrimitive::TY_TRIANGLE4 || ty == MixedPrimitive::TY_QUAD4V) {
+            while (j<n && leafType(prims[j]) == ty) j++;
+          } else if (ty == MixedPrimitive::TY_CURVE) {
+            while (j<n && leafType(prims[j]) == ty && prims[j].geomID() == prims[i].geomID()) j++;
+          }
+
+          BBox3fa b = empty;
+          for (size_t k=i; k<j; k++) b.extend(prims[k].bounds());
+          children[numChildren] = createTypedLeaf(ty,prims,range<size_t>(i,j),alloc);
+          bounds[numChildren] = b;
+          numChildren++;
+          i = j;
+        }
+
+        if (numChildren == 1)
+          return children[0];
+
+        NodeRef node = typename AABBNode::Create()(alloc);
+        for (size_t i=0; i<numChildren; i++)
+          typename AABBNode::Set()(node,i,children[i],bounds[i]);
+        return node;
+      }
+
+      void build()
+      {
+        /* skip build for empty scene */
+        const size_t numPrimitives = scene->getNumPrimitives(gtype,false);
+        if (numPrimitives == 0) {
+          bvh->clear();
+          prims.clear();
+          return;
+        }
+
+        double t0 = bvh->preBuild(TOSTRING(isa) "::BVH" + toString(N) + "MixedBuilderSAH");
+
+        /* initialize allocator, the leaf estimate assumes mostly triangles */
+        const size_t node_bytes = numPrimitives*sizeof(AABBNode)/(2*N);
+        const size_t leaf_bytes = size_t(1.2*Triangle4::blocks(numPrimitives)*sizeof(Triangle4));
+        bvh->alloc.init_estimate(node_bytes+leaf_bytes);
+        settings.singleThreadThreshold = bvh->alloc.fixSingleThreadThreshold(N,DEFAULT_SINGLE_THREAD_THRESHOLD,numPrimitives,node_bytes+leaf_bytes);
+
+        /* create primref array */
+        prims.resize(numPrimitives);
+        PrimInfo pinfo = createPrimRefArray(scene,gtype,false,numPrimitives,prims,scene->progressInterface);
+
+        /* pinfo might has zero size due to invalid geometry */
+        if (unlikely(pinfo.size() == 0))
+        {
+          bvh->clear();
+          prims.clear();
+          return;
+        }
+
+        /* call BVH builder */
+        auto createLeafFunc = [&] (const PrimRef* prims, const range<size_t>& set, const Allocator& alloc) -> NodeRef {
+          return createLeaf(prims,set,alloc);
+        };
+        NodeRef root = BVHNBuilderVirtual<N>::build(&bvh->alloc,createLeafFunc,scene->progressInterface,prims.data(),pinfo,settings);
+        bvh->set(root,LBBox3fa(pinfo.geomBounds),pinfo.size());
+        bvh->layoutLargeNodes(size_t(pinfo.size()*0.005f));
+
+        /* clear temporary data for static geometry */
+        if (scene->isStaticAccel()) {
+          prims.clear();
+        }
+        bvh->cleanup();
+        bvh->postBuild(t0);
+      }
+
+      void clear() {
+        prims.clear();
+      }
+    };
+
+    /*! entry functions for the builder */
+    Builder* BVH4MixedSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNMixedBuilderSAH<4>((BVH4*)bvh,scene); }
+  }
+}
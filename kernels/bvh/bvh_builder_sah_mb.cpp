@@ -88,6 +88,39 @@ namespace embree
       BVH* bvh;
     };
 
+    /* Recalculates the bounds of motion blur leaves for refitting, only
+     * supported for primitives that reference the mesh vertices. */
+    template<typename Mesh, typename Primitive>
+    struct RefitLeafMB
+    {
+      static const bool enabled = false;
+
+      static __forceinline unsigned int topologyVersion(const Geometry* geom) { return 0; }
+
+      static __forceinline LBBox3fa linearBounds(Scene* scene, Primitive* prims, size_t num, const BBox1f time_range) { return empty; }
+    };
+
+    template<typename Mesh, typename Primitive>
+    struct RefitLeafMBIndexed
+    {
+      static const bool enabled = true;
+
+      static __forceinline unsigned int topologyVersion(const Geometry* geom) {
+        return ((const Mesh*)geom)->getTopologyVersion();
+      }
+
+      static __forceinline LBBox3fa linearBounds(Scene* scene, Primitive* prims, size_t num, const BBox1f time_range)
+      {
+        LBBox3fa bounds = empty;
+        for (size_t i=0; i<num; i++)
+          bounds.extend(prims[i].linearBounds(scene,time_range));
+        return bounds;
+      }
+    };
+
+    template<> struct RefitLeafMB<TriangleMesh,Triangle4i> : public RefitLeafMBIndexed<TriangleMesh,Triangle4i> {};
+    template<> struct RefitLeafMB<QuadMesh,Quad4i> : public RefitLeafMBIndexed<QuadMesh,Quad4i> {};
+
     /* Motion blur BVH with 4D nodes and internal time splits */
     template<int N, typename Mesh, typename Primitive>
     struct BVHNBuilderMBlurSAH : public Builder
@@ -96,6 +129,27 @@ namespace embree
       typedef typename BVHN<N>::NodeRef NodeRef;
       typedef typename BVHN<N>::NodeRecordMB NodeRecordMB;
       typedef typename BVHN<N>::AABBNodeMB AABBNodeMB;
+      typedef typename BVHN<N>::AABBNodeMB4D AABBNodeMB4D;
+      typedef RefitLeafMB<Mesh,Primitive> RefitLeaf;
+
+      /*! state of a geometry at last full build, refitting is only possible if it did not change */
+      struct GeometryState
+      {
+        GeometryState (const Geometry* geom)
+          : geom(geom), topologyVersion(RefitLeaf::topologyVersion(geom)), numTimeSteps(geom->numTimeSteps), time_range(geom->time_range) {}
+
+        __forceinline bool operator== (const GeometryState& other) const {
+          return geom == other.geom && topologyVersion == other.topologyVersion && numTimeSteps == other.numTimeSteps &&
+            time_range.lower == other.time_range.lower && time_range.upper == other.time_range.upper;
+        }
+
+        const Geometry* geom;
+        unsigned int topologyVersion;
+        unsigned int numTimeSteps;
+        BBox1f time_range;
+      };
+
+      static const size_t PARALLEL_REFIT_DEPTH = 3; //!< refit spawns tasks up to this depth
 
       BVH* bvh;
       Scene* scene;
@@ -104,15 +158,27 @@ namespace embree
       const size_t minLeafSize;
       const size_t maxLeafSize;
       const Geometry::GTypeMask gtype_;
+      std::vector<GeometryState> buildState; //!< geometries at last full build
+      float buildCost;                       //!< SAH cost of BVH after last full build
 
       BVHNBuilderMBlurSAH (BVH* bvh, Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const Geometry::GTypeMask gtype)
-        : bvh(bvh), scene(scene), sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)), gtype_(gtype) {}
+        : bvh(bvh), scene(scene), sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)), gtype_(gtype), buildCost(0.0f) {}
 
       void build()
       {
 	/* skip build for empty scene */
         const size_t numPrimitives = scene->getNumPrimitives(gtype_,true);
-        if (numPrimitives == 0) { bvh->clear(); return; }
+        if (numPrimitives == 0) { bvh->clear(); buildState.clear(); return; }
+
+        /* refit BVH when the topology of all geometries stayed the same */
+        std::vector<GeometryState> state;
+        const bool refittable = getGeometryState(state);
+        if (refittable && bvh->root != BVH::emptyNode && state.size() == buildState.size() && std::equal(state.begin(),state.end(),buildState.begin()))
+        {
+          if (refit()) return;
+          if (scene->device->verbosity(2))
+            std::cout << "BVH" << N << "BuilderMBlurSAH: refit exceeded quality threshold, rebuilding" << std::endl;
+        }
 
         double t0 = bvh->preBuild(TOSTRING(isa) "::BVH" + toString(N) + "BuilderMBlurSAH");
 
@@ -135,6 +201,119 @@ namespace embree
 	/* clear temporary data for static geometry */
 	bvh->cleanup();
         bvh->postBuild(t0);
+
+        /* remember build state to refit later on */
+        if (refittable && bvh->root != BVH::emptyNode) {
+          buildState = std::move(state);
+          buildCost = sahCost(bvh->root);
+        } else {
+          buildState.clear();
+        }
+      }
+
+      /* collects state of all motion blur geometries, returns true if all can get refitted */
+      bool getGeometryState(std::vector<GeometryState>& state) const
+      {
+        if (!RefitLeaf::enabled) return false;
+
+        Scene::Iterator2 iter(scene,gtype_,true);
+        for (size_t i=0; i<iter.size(); i++)
+        {
+          Geometry* geom = iter[i];
+          if (geom == nullptr) continue;
+          if (geom->quality != RTC_BUILD_QUALITY_REFIT) return false;
+          state.push_back(GeometryState(geom));
+        }
+        return true;
+      }
+
+      /* refits the BVH in place, returns false if the BVH quality degraded too much */
+      bool refit()
+      {
+        double t0 = bvh->preBuild(TOSTRING(isa) "::BVH" + toString(N) + "RefitMBlur");
+        float cost = 0.0f;
+        const LBBox3fa bounds = refit(bvh->root,BBox1f(0.0f,1.0f),cost,0);
+        bvh->bounds = bounds;
+        bvh->postBuild(t0);
+        return cost <= scene->device->mblur_refit_threshold*buildCost;
+      }
+
+      /* updates the linear bounds of all children for their time range and returns the bounds of the subtree */
+      LBBox3fa refit(NodeRef ref, const BBox1f time_range, float& cost, size_t depth)
+      {
+        if (ref.isLeaf()) {
+          size_t num; Primitive* prims = (Primitive*) ref.leaf(num);
+          return RefitLeaf::linearBounds(scene,prims,num,time_range);
+        }
+
+        const bool timeSplit = ref.isAABBNodeMB4D();
+        AABBNodeMB* node = ref.getAABBNodeMB();
+        LBBox3fa cbounds[N];
+        float ccost[N];
+        auto refitChild = [&] (size_t i) {
+          ccost[i] = 0.0f;
+          if (node->child(i) == BVH::emptyNode) return;
+          const BBox1f dt = timeSplit ? intersect(ref.getAABBNodeMB4D()->timeRange(i),time_range) : time_range;
+          cbounds[i] = refit(node->child(i),dt,ccost[i],depth+1);
+          if (timeSplit) {
+            ref.getAABBNodeMB4D()->setBounds(i,cbounds[i],dt);
+            ccost[i] += ref.getAABBNodeMB4D()->expectedHalfArea(i);
+          } else {
+            node->setBounds(i,cbounds[i],dt);
+            ccost[i] += node->expectedHalfArea(i);
+          }
+        };
+
+        if (depth < PARALLEL_REFIT_DEPTH)
+          parallel_for(size_t(0), size_t(N), [&] (const range<size_t>& r) {
+              for (size_t i=r.begin(); i<r.end(); i++) refitChild(i);
+            });
+        else
+          for (size_t i=0; i<N; i++) refitChild(i);
+
+        LBBox3fa bounds = empty;
+        for (size_t i=0; i<N; i++) {
+          if (node->child(i) == BVH::emptyNode) continue;
+          cost += ccost[i];
+          bounds.extend(cbounds[i]);
+        }
+
+        /* children of nodes with time splits only cover parts of the time range, thus recalculate bounds from primitives */
+        if (timeSplit) bounds = linearBounds(ref,time_range);
+        return bounds;
+      }
+
+      /* calculates the linear bounds of all primitives of a subtree */
+      LBBox3fa linearBounds(NodeRef ref, const BBox1f time_range)
+      {
+        if (ref.isLeaf()) {
+          size_t num; Primitive* prims = (Primitive*) ref.leaf(num);
+          return RefitLeaf::linearBounds(scene,prims,num,time_range);
+        }
+
+        AABBNodeMB* node = ref.getAABBNodeMB();
+        LBBox3fa bounds = empty;
+        for (size_t i=0; i<N; i++) {
+          if (node->child(i) == BVH::emptyNode) continue;
+          bounds.extend(linearBounds(node->child(i),time_range));
+        }
+        return bounds;
+      }
+
+      /* calculates sum of expected child surface areas over all inner nodes */
+      float sahCost(NodeRef ref)
+      {
+        if (ref.isLeaf()) return 0.0f;
+
+        const bool timeSplit = ref.isAABBNodeMB4D();
+        AABBNodeMB* node = ref.getAABBNodeMB();
+        float cost = 0.0f;
+        for (size_t i=0; i<N; i++) {
+          if (node->child(i) == BVH::emptyNode) continue;
+          cost += timeSplit ? ref.getAABBNodeMB4D()->expectedHalfArea(i) : node->expectedHalfArea(i);
+          cost += sahCost(node->child(i));
+        }
+        return cost;
       }
 
 #if 0 // No longer compatible when time_ranges are present for geometries. Would have to create temporal nodes sometimes, and put only a single geometry into leaf.
@@ -212,6 +391,7 @@ namespace embree
       }
 
       void clear() {
+        buildState.clear();
       }
     };
 
@@ -35,7 +35,7 @@ namespace embree
         parallel_for(num, bvh->objects.size(), [&] (const range<size_t>& r) {
             for (size_t i=r.begin(); i<r.end(); i++) {
               builders[i].reset();
-              delete bvh->objects[i]; bvh->objects[i] = nullptr;
+              bvh->objects[i] = nullptr;
             }
           });
       }
@@ -224,14 +224,15 @@ namespace embree
     {
       if (geomID >= bvh->objects.size()) return;
       if (builders[geomID]) builders[geomID].reset();
-      delete bvh->objects [geomID]; bvh->objects [geomID] = nullptr;
+      bvh->objects [geomID] = nullptr;
     }
 
     template<int N, typename Mesh, typename Primitive>
     void BVHNBuilderTwoLevel<N,Mesh,Primitive>::clear()
     {
+      /* BVHs might be shared with other scenes, thus we only drop our references */
       for (size_t i=0; i<bvh->objects.size(); i++) 
-        if (bvh->objects[i]) bvh->objects[i]->clear();
+        bvh->objects[i] = nullptr;
 
       for (size_t i=0; i<builders.size(); i++) 
         if (builders[i]) builders[i].reset();
@@ -292,17 +293,52 @@ namespace embree
     template<int N, typename Mesh, typename Primitive>
     void BVHNBuilderTwoLevel<N,Mesh,Primitive>::setupLargeBuildRefBuilder (size_t objectID, Mesh const * const mesh)
     {
-      if (bvh->objects[objectID] == nullptr ||                                  // new mesh
+      /* refitting modifies the BVH in place, thus refitted BVHs are not shared across scenes */
+      if (mesh->quality != RTC_BUILD_QUALITY_REFIT)
+      {
+        if (builders[objectID] == nullptr ||                                       // new mesh
+            builders[objectID]->meshQualityChanged (mesh->quality) ||             // changed build quality
+            dynamic_cast<RefBuilderShared*>(builders[objectID].get()) == nullptr) // size change resulted in small->large change
+        {
+          bvh->objects[objectID] = nullptr;
+          builders[objectID].reset (new RefBuilderShared(objectID, mesh->quality));
+        }
+        return;
+      }
+
+      if (bvh->objects[objectID] == null ||                                     // new mesh
           builders[objectID]->meshQualityChanged (mesh->quality) ||             // changed build quality
           dynamic_cast<RefBuilderLarge*>(builders[objectID].get()) == nullptr)  // size change resulted in small->large change
       {
         Builder* builder = nullptr;
-        delete bvh->objects[objectID]; 
         createMeshAccel(objectID, builder);
         builders[objectID].reset (new RefBuilderLarge(objectID, builder, mesh->quality));
       }
     }
 
+    template<int N, typename Mesh, typename Primitive>
+    Ref<BVHN<N>> BVHNBuilderTwoLevel<N,Mesh,Primitive>::getSharedMeshAccel (size_t geomID)
+    {
+      Mesh* mesh = getMesh(geomID);
+      const bool usePLOCBuilder = scene->device->medium_quality_builder == "ploc";
+      const Geometry::AccelKey key(&Primitive::type,N,unsigned(geomID),unsigned(gtype),unsigned(mesh->quality) | (useMortonBuilder_ << 4) | (usePLOCBuilder << 5),scene->isStaticAccel());
+
+      /* reuse the BVH another scene built for this geometry */
+      Ref<AccelData> shared = mesh->getSharedAccel(key);
+      if (shared) return (BVH*) shared.ptr;
+
+      /* otherwise build it and share it, if another scene was faster its BVH wins */
+      Ref<BVH> object = new BVH(Primitive::type,scene);
+      Builder* builder = nullptr;
+      __internal_two_level_builder__::MeshBuilder<N,Mesh,Primitive>()(object.ptr, mesh, geomID, gtype, useMortonBuilder_, usePLOCBuilder, builder);
+      Ref<Builder>(builder)->build();
+
+      /* the BVH may outlive the scene that built it, and the scene is only needed during the build */
+      object->scene = nullptr;
+      shared = mesh->setSharedAccel(key,object.ptr);
+      return (BVH*) shared.ptr;
+    }
+
 #if defined(EMBREE_GEOMETRY_TRIANGLE)
     Builder* BVH4BuilderTwoLevelTriangle4MeshSAH (void* bvh, Scene* scene, bool useMortonBuilder) {
       return new BVHNBuilderTwoLevel<4,TriangleMesh,Triangle4>((BVH4*)bvh,scene,TriangleMesh::geom_type,useMortonBuilder);
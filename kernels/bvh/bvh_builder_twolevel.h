@@ -199,12 +199,50 @@ namespace embree
         RTCBuildQuality quality_;
       };
 
+      /* references the BVH of a geometry that is shared by all scenes the geometry is attached to */
+      class RefBuilderShared : public RefBuilderBase {
+      public:
+
+        RefBuilderShared (size_t objectID, RTCBuildQuality quality)
+        : objectID_ (objectID), quality_ (quality) {}
+
+        void attachBuildRefs (BVHNBuilderTwoLevel* topBuilder)
+        {
+          /* get BVH of the geometry again if it got modified */
+          if (topBuilder->isGeometryModified(objectID_) || !topBuilder->getBVH(objectID_))
+            topBuilder->bvh->objects[objectID_] = topBuilder->getSharedMeshAccel(objectID_);
+          BVH* object = topBuilder->getBVH(objectID_); assert(object);
+
+          /* create build primitive */
+          if (!object->getBounds().empty())
+          {
+#if ENABLE_DIRECT_SAH_MERGE_BUILDER
+            Mesh* mesh = topBuilder->getMesh(objectID_);
+            topBuilder->refs[topBuilder->nextRef++] = BVHNBuilderTwoLevel::BuildRef(object->getBounds(),object->root,(unsigned int)objectID_,(unsigned int)mesh->size());
+#else
+            topBuilder->refs[topBuilder->nextRef++] = BVHNBuilderTwoLevel::BuildRef(object->getBounds(),object->root);
+#endif
+          }
+        }
+
+        bool meshQualityChanged (RTCBuildQuality currQuality) {
+          return currQuality != quality_;
+        }
+
+      private:
+        size_t          objectID_;
+        RTCBuildQuality quality_;
+      };
+
       void setupLargeBuildRefBuilder (size_t objectID, Mesh const * const mesh);
       void setupSmallBuildRefBuilder (size_t objectID, Mesh const * const mesh);
 
       BVH*  getBVH (size_t objectID) {
-        return this->bvh->objects[objectID];
+        return this->bvh->objects[objectID].ptr;
       }
+
+      /* returns the BVH over a single geometry shared by all scenes with matching build settings */
+      Ref<BVH> getSharedMeshAccel (size_t geomID);
       Mesh* getMesh (size_t objectID) {
         return this->scene->template getSafe<Mesh>(objectID);
       }
@@ -237,14 +275,14 @@ namespace embree
       void createMeshAccel (size_t geomID, Builder*& builder)
       {
         bvh->objects[geomID] = new BVH(Primitive::type,scene);
-        BVH* accel = bvh->objects[geomID];
+        BVH* accel = bvh->objects[geomID].ptr;
         auto mesh = scene->getSafe<Mesh>(geomID);
         if (nullptr == mesh) {
           throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"geomID does not return correct type");
           return;
         }
 
-        __internal_two_level_builder__::MeshBuilder<N,Mesh,Primitive>()(accel, mesh, geomID, this->gtype, this->useMortonBuilder_, builder);
+        __internal_two_level_builder__::MeshBuilder<N,Mesh,Primitive>()(accel, mesh, geomID, this->gtype, this->useMortonBuilder_, this->scene->device->medium_quality_builder == "ploc", builder);
       }      
 
       using BuilderList = std::vector<std::unique_ptr<RefBuilderBase>>;
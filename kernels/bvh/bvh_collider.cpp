@@ -21,18 +21,47 @@ namespace embree
     CSTAT(std::atomic<size_t> bvh_collide_prim_intersections5(0));
     CSTAT(std::atomic<size_t> bvh_collide_prim_intersections(0));
 
-    struct Collision
+    __forceinline void setCollision(RTCCollision& c, unsigned geomID0, unsigned primID0, const unsigned* instID0, unsigned geomID1, unsigned primID1, const unsigned* instID1)
     {
-      __forceinline Collision() {}
+      c.geomID0 = geomID0; c.primID0 = primID0;
+      c.geomID1 = geomID1; c.primID1 = primID1;
+    }
 
-      __forceinline Collision (unsigned geomID0, unsigned primID0, unsigned geomID1, unsigned primID1)
-        : geomID0(geomID0), primID0(primID0), geomID1(geomID1), primID1(primID1) {}
+    __forceinline void setCollision(RTCCollisionInstanced& c, unsigned geomID0, unsigned primID0, const unsigned* instID0, unsigned geomID1, unsigned primID1, const unsigned* instID1)
+    {
+      c.geomID0 = geomID0; c.primID0 = primID0;
+      c.geomID1 = geomID1; c.primID1 = primID1;
+      for (unsigned l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++) {
+        c.instID0[l] = instID0[l];
+        c.instID1[l] = instID1[l];
+      }
+    }
 
-      unsigned geomID0;
-      unsigned primID0;
-      unsigned geomID1;
-      unsigned primID1;
-    };
+    /* reports all primitive pairs of two user geometry leaves in batches of 16 */
+    template<typename Collision, typename Callback>
+    __forceinline void reportCollisions(Callback callback, void* userPtr, bool self,
+                                        const Object* leaf0, size_t N0, const unsigned* instID0,
+                                        const Object* leaf1, size_t N1, const unsigned* instID1)
+    {
+      Collision collisions[16];
+      unsigned int num_collisions = 0;
+      for (size_t i=0; i<N0; i++) {
+        for (size_t j=0; j<N1; j++) {
+          const unsigned geomID0 = leaf0[i].geomID();
+          const unsigned primID0 = leaf0[i].primID();
+          const unsigned geomID1 = leaf1[j].geomID();
+          const unsigned primID1 = leaf1[j].primID();
+          if (self && geomID0 == geomID1 && primID0 == primID1) continue;
+          setCollision(collisions[num_collisions++],geomID0,primID0,instID0,geomID1,primID1,instID1);
+          if (num_collisions == 16) {
+            callback(userPtr,collisions,num_collisions);
+            num_collisions = 0;
+          }
+        }
+      }
+      if (num_collisions)
+        callback(userPtr,collisions,num_collisions);
+    }
     
     template<int N>
     __forceinline size_t overlap(const BBox3fa& box0, const typename BVHN<N>::AABBNode& node1)
@@ -70,6 +99,26 @@ namespace embree
       return movemask((lower_x <= upper_x) & (lower_y <= upper_y) & (lower_z <= upper_z));
     }
 
+    /* transforms the child bounds of a node into world space */
+    template<int N>
+    __forceinline BBox<Vec3<vfloat<N>>> xfmBounds(const AffineSpace3fa& local2world, const typename BVHN<N>::AABBNode& node)
+    {
+      const Vec3vf<N> lower(node.lower_x,node.lower_y,node.lower_z);
+      const Vec3vf<N> upper(node.upper_x,node.upper_y,node.upper_z);
+      const Vec3vf<N> center = vfloat<N>(0.5f)*(lower+upper);
+      const Vec3vf<N> extent = vfloat<N>(0.5f)*(upper-lower);
+      const AffineSpace3vf<N> xfm(local2world);
+      const Vec3vf<N> c = xfmPoint(xfm,center);
+      const Vec3vf<N> e = abs(xfm.l.vx)*extent.x + abs(xfm.l.vy)*extent.y + abs(xfm.l.vz)*extent.z;
+      return BBox<Vec3<vfloat<N>>>(c-e,c+e); // empty children produce NaNs and do not overlap
+    }
+
+    template<int N>
+    __forceinline BBox3fa extract(const BBox<Vec3<vfloat<N>>>& bounds, size_t i) {
+      return BBox3fa(Vec3fa(bounds.lower.x[i],bounds.lower.y[i],bounds.lower.z[i]),
+                     Vec3fa(bounds.upper.x[i],bounds.upper.y[i],bounds.upper.z[i]));
+    }
+
     bool intersect_triangle_triangle (Scene* scene0, unsigned geomID0, unsigned primID0, Scene* scene1, unsigned geomID1, unsigned primID1)
     {
       CSTAT(bvh_collide_prim_intersections1++);
@@ -108,29 +157,126 @@ namespace embree
     }
     
     template<int N>
-    __forceinline void BVHNColliderUserGeom<N>::processLeaf(NodeRef node0, NodeRef node1)
+    BVHNColliderUserGeom<N>::InstanceSpace::InstanceSpace (Scene* scene)
+      : scene(scene), bvh(nullptr), local2world(one), depth(0)
     {
-      Collision collisions[16];
-      size_t num_collisions = 0;
+      for (unsigned l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+        instID[l] = RTC_INVALID_GEOMETRY_ID;
 
-      size_t N0; Object* leaf0 = (Object*) node0.leaf(N0);
-      size_t N1; Object* leaf1 = (Object*) node1.leaf(N1);
-      for (size_t i=0; i<N0; i++) {
-        for (size_t j=0; j<N1; j++) {
-          const unsigned geomID0 = leaf0[i].geomID();
-          const unsigned primID0 = leaf0[i].primID();
-          const unsigned geomID1 = leaf1[j].geomID();
-          const unsigned primID1 = leaf1[j].primID();
-          if (this->scene0 == this->scene1 && geomID0 == geomID1 && primID0 == primID1) continue;
-          collisions[num_collisions++] = Collision(geomID0,primID0,geomID1,primID1);
-          if (num_collisions == 16) {
-            this->callback(this->userPtr,(RTCCollision*)&collisions,num_collisions);
-            num_collisions = 0;
-          }
+      if (scene->numPrimitives() == 0)
+        return;
+
+      scene->visitLazy();
+
+      /* only scenes consisting of a single BVH over user geometries or instances are supported */
+      const size_t numUserGeometries = scene->getNumPrimitives(Geometry::MTY_USER_GEOMETRY,false);
+      const size_t numInstances = scene->getNumPrimitives(Geometry::MTY_INSTANCE,false);
+      AccelData* accel = scene->intersectors.ptr;
+      if ((scene->numPrimitives() != numUserGeometries && scene->numPrimitives() != numInstances) ||
+          accel == nullptr || accel->type != (N == 4 ? AccelData::TY_BVH4 : AccelData::TY_BVH8))
+        throw_RTCError(RTC_ERROR_INVALID_OPERATION,"collision detection only supports scenes of either user geometries or instances without motion blur");
+      bvh = (BVH*) accel;
+    }
+
+    template<int N>
+    BVHNColliderUserGeom<N>::InstanceSpace::InstanceSpace (const InstanceSpace& parent, const Instance* instance, unsigned int instID_)
+      : InstanceSpace((Scene*)instance->object)
+    {
+      if (parent.depth >= RTC_MAX_INSTANCE_LEVEL_COUNT)
+        throw_RTCError(RTC_ERROR_INVALID_OPERATION,"too many nested instance levels for collision detection");
+
+      local2world = parent.local2world * instance->getLocal2World();
+      for (unsigned l=0; l<parent.depth; l++)
+        instID[l] = parent.instID[l];
+      instID[parent.depth] = instID_;
+      depth = parent.depth+1;
+    }
+
+    template<int N>
+    void BVHNColliderUserGeom<N>::processLeaf(NodeRef node0, const BBox3fa& bounds0, NodeRef node1, const BBox3fa& bounds1) {
+      processLeaf(root0,node0,bounds0,root1,node1,bounds1);
+    }
+
+    template<int N>
+    void BVHNColliderUserGeom<N>::processLeaf(const InstanceSpace& space0, NodeRef node0, const BBox3fa& bounds0, const InstanceSpace& space1, NodeRef node1, const BBox3fa& bounds1)
+    {
+      /* descend into the instanced scenes of instance leaves */
+      if (space0.isInstanceBVH())
+      {
+        size_t N0; const InstancePrimitive* leaf0 = (const InstancePrimitive*) node0.leaf(N0);
+        for (size_t i=0; i<N0; i++)
+        {
+          const Instance* instance = leaf0[i].instance;
+          if (instance->numTimeSteps != 1)
+            throw_RTCError(RTC_ERROR_INVALID_OPERATION,"collision detection does not support motion blurred instances");
+          const InstanceSpace child(space0,instance,leaf0[i].instID_);
+          if (child.bvh == nullptr) continue;
+          const BBox3fa bounds = xfmBounds(child.local2world,child.bvh->getBounds());
+          if (disjoint(bounds,bounds1)) continue;
+          collide_instances(child,child.bvh->root,bounds,space1,node1,bounds1);
+        }
+        return;
+      }
+
+      if (space1.isInstanceBVH())
+      {
+        size_t N1; const InstancePrimitive* leaf1 = (const InstancePrimitive*) node1.leaf(N1);
+        for (size_t i=0; i<N1; i++)
+        {
+          const Instance* instance = leaf1[i].instance;
+          if (instance->numTimeSteps != 1)
+            throw_RTCError(RTC_ERROR_INVALID_OPERATION,"collision detection does not support motion blurred instances");
+          const InstanceSpace child(space1,instance,leaf1[i].instID_);
+          if (child.bvh == nullptr) continue;
+          const BBox3fa bounds = xfmBounds(child.local2world,child.bvh->getBounds());
+          if (disjoint(bounds,bounds0)) continue;
+          collide_instances(space0,node0,bounds0,child,child.bvh->root,bounds);
+        }
+        return;
+      }
+
+      /* a primitive does not collide with itself */
+      const bool self = space0.scene == space1.scene && space0.sameInstances(space1);
+
+      size_t N0; const Object* leaf0 = (const Object*) node0.leaf(N0);
+      size_t N1; const Object* leaf1 = (const Object*) node1.leaf(N1);
+      if (this->callbackInstanced)
+        reportCollisions<RTCCollisionInstanced>(this->callbackInstanced,this->userPtr,self,leaf0,N0,space0.instID,leaf1,N1,space1.instID);
+      else
+        reportCollisions<RTCCollision>(this->callback,this->userPtr,self,leaf0,N0,space0.instID,leaf1,N1,space1.instID);
+    }
+
+    template<int N>
+    void BVHNColliderUserGeom<N>::collide_instances(const InstanceSpace& space0, NodeRef ref0, const BBox3fa& bounds0, const InstanceSpace& space1, NodeRef ref1, const BBox3fa& bounds1)
+    {
+      CSTAT(bvh_collide_traversal_steps++);
+      if (unlikely(ref0.isLeaf() && ref1.isLeaf())) {
+        CSTAT(bvh_collide_leaf_pairs++);
+        processLeaf(space0,ref0,bounds0,space1,ref1,bounds1);
+        return;
+      }
+
+      /* the bounds of both sides are in world space, thus child bounds get transformed before the overlap test */
+      if (!ref0.isLeaf() && (ref1.isLeaf() || area(bounds0) > area(bounds1)))
+      {
+        const AABBNode* node0 = ref0.getAABBNode();
+        const BBox<Vec3vf<N>> cbounds = xfmBounds<N>(space0.local2world,*node0);
+        size_t mask = overlap<N>(bounds1,cbounds);
+        for (size_t m=mask, i=bsf(m); m!=0; m=btc(m,i), i=bsf(m)) {
+          BVHN<N>::prefetch(node0->child(i),BVH_FLAG_ALIGNED_NODE);
+          collide_instances(space0,node0->child(i),extract<N>(cbounds,i),space1,ref1,bounds1);
+        }
+      }
+      else
+      {
+        const AABBNode* node1 = ref1.getAABBNode();
+        const BBox<Vec3vf<N>> cbounds = xfmBounds<N>(space1.local2world,*node1);
+        size_t mask = overlap<N>(bounds0,cbounds);
+        for (size_t m=mask, i=bsf(m); m!=0; m=btc(m,i), i=bsf(m)) {
+          BVHN<N>::prefetch(node1->child(i),BVH_FLAG_ALIGNED_NODE);
+          collide_instances(space0,ref0,bounds0,space1,node1->child(i),extract<N>(cbounds,i));
         }
       }
-      if (num_collisions)
-        this->callback(this->userPtr,(RTCCollision*)&collisions,num_collisions);
     }
 
     template<int N>
@@ -140,7 +286,7 @@ namespace embree
       if (unlikely(ref0.isLeaf())) {
         if (unlikely(ref1.isLeaf())) {
           CSTAT(bvh_collide_leaf_pairs++);
-          processLeaf(ref0,ref1);
+          processLeaf(ref0,bounds0,ref1,bounds1);
           return;
         } else goto recurse_node1;
         
@@ -319,10 +465,15 @@ namespace embree
     }
    
     template<int N>
-    void BVHNColliderUserGeom<N>::collide(BVH* __restrict__ bvh0, BVH* __restrict__ bvh1, RTCCollideFunc callback, void* userPtr)
+    void BVHNColliderUserGeom<N>::collide(BVH* __restrict__ bvh0, BVH* __restrict__ bvh1, RTCCollideFunc callback, RTCCollideInstancedFunc callbackInstanced, void* userPtr)
     { 
-      BVHNColliderUserGeom<N>(bvh0->scene,bvh1->scene,callback,userPtr).
-        collide_recurse_entry(bvh0->root,bvh0->bounds.bounds(),bvh1->root,bvh1->bounds.bounds());
+      BVHNColliderUserGeom<N> collider(bvh0->scene,bvh1->scene,callback,callbackInstanced,userPtr);
+
+      /* only rtcCollideInstanced can report the instance IDs of a collision */
+      if (callbackInstanced == nullptr && (collider.root0.isInstanceBVH() || collider.root1.isInstanceBVH()))
+        throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scenes with instances require rtcCollideInstanced");
+
+      collider.collide_recurse_entry(bvh0->root,bvh0->bounds.bounds(),bvh1->root,bvh1->bounds.bounds());
     }
 
 #if defined (EMBREE_LOWEST_ISA)
@@ -6,6 +6,7 @@
 #include "bvh.h"
 #include "../geometry/trianglev.h"
 #include "../geometry/object.h"
+#include "../geometry/instance.h"
 
 namespace embree
 {
@@ -39,18 +40,19 @@ namespace embree
       void split(const CollideJob& job, jobvector& jobs);
       
     public:
-      __forceinline BVHNCollider (Scene* scene0, Scene* scene1, RTCCollideFunc callback, void* userPtr)
-        : scene0(scene0), scene1(scene1), callback(callback), userPtr(userPtr) {}
+      __forceinline BVHNCollider (Scene* scene0, Scene* scene1, RTCCollideFunc callback, RTCCollideInstancedFunc callbackInstanced, void* userPtr)
+        : scene0(scene0), scene1(scene1), callback(callback), callbackInstanced(callbackInstanced), userPtr(userPtr) {}
 
     public:
-      virtual void processLeaf(NodeRef leaf0, NodeRef leaf1) = 0;
+      virtual void processLeaf(NodeRef leaf0, const BBox3fa& bounds0, NodeRef leaf1, const BBox3fa& bounds1) = 0;
       void collide_recurse(NodeRef node0, const BBox3fa& bounds0, NodeRef node1, const BBox3fa& bounds1, size_t depth0, size_t depth1);
       void collide_recurse_entry(NodeRef node0, const BBox3fa& bounds0, NodeRef node1, const BBox3fa& bounds1);
     
     protected:
       Scene* scene0;
       Scene* scene1;
-      RTCCollideFunc callback;
+      RTCCollideFunc callback;                    //!< callback of rtcCollide
+      RTCCollideInstancedFunc callbackInstanced;  //!< callback of rtcCollideInstanced
       void* userPtr;
     };
 
@@ -61,12 +63,47 @@ namespace embree
       typedef typename BVH::NodeRef NodeRef;
       typedef typename BVH::AABBNode AABBNode;
 
-      __forceinline BVHNColliderUserGeom (Scene* scene0, Scene* scene1, RTCCollideFunc callback, void* userPtr)
-        : BVHNCollider<N>(scene0,scene1,callback,userPtr) {}
+      /* Space of one side of the collision, the BVH of the scene
+       * is transformed into world space by the instances traversed so far */
+      struct InstanceSpace
+      {
+        InstanceSpace (Scene* scene);
+        InstanceSpace (const InstanceSpace& parent, const Instance* instance, unsigned int instID);
+
+        /* tests if both spaces are reached through the same instances */
+        __forceinline bool sameInstances(const InstanceSpace& other) const
+        {
+          if (depth != other.depth) return false;
+          for (unsigned l=0; l<depth; l++)
+            if (instID[l] != other.instID[l]) return false;
+          return true;
+        }
+
+        /* tests if the BVH of the scene stores instances */
+        __forceinline bool isInstanceBVH() const {
+          return bvh && bvh->primTy == &InstancePrimitive::type;
+        }
+
+        Scene* scene;
+        BVH* bvh;                                       //!< BVH of the scene, nullptr for empty scenes
+        AffineSpace3fa local2world;                     //!< transformation of the scene into world space
+        unsigned int instID[RTC_MAX_INSTANCE_LEVEL_COUNT]; //!< instance IDs traversed to reach the scene
+        unsigned int depth;                             //!< number of instances traversed to reach the scene
+      };
+
+      __forceinline BVHNColliderUserGeom (Scene* scene0, Scene* scene1, RTCCollideFunc callback, RTCCollideInstancedFunc callbackInstanced, void* userPtr)
+        : BVHNCollider<N>(scene0,scene1,callback,callbackInstanced,userPtr), root0(scene0), root1(scene1) {}
+
+      virtual void processLeaf(NodeRef leaf0, const BBox3fa& bounds0, NodeRef leaf1, const BBox3fa& bounds1);
+      void processLeaf(const InstanceSpace& space0, NodeRef leaf0, const BBox3fa& bounds0, const InstanceSpace& space1, NodeRef leaf1, const BBox3fa& bounds1);
+      void collide_instances(const InstanceSpace& space0, NodeRef ref0, const BBox3fa& bounds0, const InstanceSpace& space1, NodeRef ref1, const BBox3fa& bounds1);
+
+    private:
+      const InstanceSpace root0;  //!< space of the first scene
+      const InstanceSpace root1;  //!< space of the second scene
 
-      virtual void processLeaf(NodeRef leaf0, NodeRef leaf1);
     public:
-      static void collide(BVH* __restrict__ bvh0, BVH* __restrict__ bvh1, RTCCollideFunc callback, void* userPtr);
+      static void collide(BVH* __restrict__ bvh0, BVH* __restrict__ bvh1, RTCCollideFunc callback, RTCCollideInstancedFunc callbackInstanced, void* userPtr);
     };
   }
 }
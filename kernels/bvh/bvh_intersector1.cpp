@@ -22,6 +22,8 @@
 #include "../geometry/subgrid_intersector.h"
 #include "../geometry/subgrid_mb_intersector.h"
 #include "../geometry/curve_intersector_virtual.h"
+#include "../geometry/mixed_intersector.h"
+#include "../geometry/trianglef_intersector.h"
 
 namespace embree
 {
@@ -66,6 +68,9 @@ namespace embree
       /* initialize the node traverser */
       BVHNNodeTraverser1Hit<N, types> nodeTraverser;
 
+      /* traversal statistics of the scene */
+      TraversalCounters counters(context->scene->getStatistics());
+
       /* pop loop */
       while (true) pop:
       {
@@ -86,6 +91,7 @@ namespace embree
           STAT3(normal.trav_nodes,1,1,1);
           bool nodeIntersected = BVHNNodeIntersector1<N, types, robust>::intersect(cur, tray, ray.time(), tNear, mask);
           if (unlikely(!nodeIntersected)) { STAT3(normal.trav_nodes,-1,-1,-1); break; }
+          counters.node();
 
           /* if no child is hit, pop next node */
           if (unlikely(mask == 0))
@@ -99,6 +105,7 @@ namespace embree
         assert(cur != BVH::emptyNode);
         STAT3(normal.trav_leaves,1,1,1);
         size_t num; Primitive* prim = (Primitive*)cur.leaf(num);
+        counters.leaf(bvh->primTy,(const char*)prim,num);
         size_t lazy_node = 0;
         PrimitiveIntersector1::intersect(This, pre, ray, context, prim, num, tray, lazy_node);
         tray.tfar = ray.tfar;
@@ -152,6 +159,9 @@ namespace embree
       /* initialize the node traverser */
       BVHNNodeTraverser1Hit<N, types> nodeTraverser;
 
+      /* traversal statistics of the scene */
+      TraversalCounters counters(context->scene->getStatistics());
+
       /* pop loop */
       while (true) pop:
       {
@@ -168,6 +178,7 @@ namespace embree
           STAT3(shadow.trav_nodes,1,1,1);
           bool nodeIntersected = BVHNNodeIntersector1<N, types, robust>::intersect(cur, tray, ray.time(), tNear, mask);
           if (unlikely(!nodeIntersected)) { STAT3(shadow.trav_nodes,-1,-1,-1); break; }
+          counters.node();
 
           /* if no child is hit, pop next node */
           if (unlikely(mask == 0))
@@ -181,6 +192,7 @@ namespace embree
         assert(cur != BVH::emptyNode);
         STAT3(shadow.trav_leaves,1,1,1);
         size_t num; Primitive* prim = (Primitive*)cur.leaf(num);
+        counters.leaf(bvh->primTy,(const char*)prim,num);
         size_t lazy_node = 0;
         if (PrimitiveIntersector1::occluded(This, pre, ray, context, prim, num, tray, lazy_node)) {
           ray.tfar = neg_inf;
@@ -231,6 +243,9 @@ namespace embree
         /* initialize the node traverser */
         BVHNNodeTraverser1Hit<N,types> nodeTraverser;
 
+        /* traversal statistics of the scene */
+        TraversalCounters counters(context->scene->getStatistics());
+
         bool changed = false;
         float cull_radius = context->query_type == POINT_QUERY_TYPE_SPHERE
                           ? query->radius * query->radius
@@ -261,6 +276,7 @@ namespace embree
               nodeIntersected = BVHNNodePointQueryAABB1  <N, types>::pointQuery(cur, tquery, query->time, tNear, mask);
             }
             if (unlikely(!nodeIntersected)) { STAT3(point_query.trav_nodes,-1,-1,-1); break; }
+            counters.node();
 
             /* if no child is hit, pop next node */
             if (unlikely(mask == 0))
@@ -274,6 +290,7 @@ namespace embree
           assert(cur != BVH::emptyNode);
           STAT3(point_query.trav_leaves,1,1,1);
           size_t num; Primitive* prim = (Primitive*)cur.leaf(num);
+          counters.leaf(bvh->primTy,(const char*)prim,num);
           size_t lazy_node = 0;
           if (PrimitiveIntersector1::pointQuery(This, query, context, prim, num, tquery, lazy_node))
           {
@@ -23,6 +23,8 @@
 #include "../geometry/subgrid_intersector.h"
 #include "../geometry/subgrid_mb_intersector.h"
 #include "../geometry/curve_intersector_virtual.h"
+#include "../geometry/mixed_intersector.h"
+#include "../geometry/trianglef_intersector.h"
 
 #define SWITCH_DURING_DOWN_TRAVERSAL 1
 #define FORCE_SINGLE_MODE 0
@@ -54,6 +56,9 @@ namespace embree
       TravRay<N,robust> tray1;
       tray1.template init<K>(k, tray.org, tray.dir, tray.rdir, tray.nearXYZ, tray.tnear[k], tray.tfar[k]);
 
+      /* traversal statistics of the scene */
+      TraversalCounters counters(context->scene->getStatistics());
+
       /* pop loop */
       while (true) pop:
       {
@@ -74,6 +79,7 @@ namespace embree
           STAT3(normal.trav_nodes, 1, 1, 1);
           bool nodeIntersected = BVHNNodeIntersector1<N, types, robust>::intersect(cur, tray1, ray.time()[k], tNear, mask);
           if (unlikely(!nodeIntersected)) { STAT3(normal.trav_nodes,-1,-1,-1); break; }
+          counters.node();
 
           /* if no child is hit, pop next node */
           if (unlikely(mask == 0))
@@ -87,6 +93,7 @@ namespace embree
         assert(cur != BVH::emptyNode);
         STAT3(normal.trav_leaves, 1, 1, 1);
         size_t num; Primitive* prim = (Primitive*)cur.leaf(num);
+        counters.leaf(bvh->primTy,(const char*)prim,num);
 
         size_t lazy_node = 0;
         PrimitiveIntersectorK::intersect(This, pre, ray, k, context, prim, num, tray1, lazy_node);
@@ -160,8 +167,8 @@ namespace embree
         return;
       }
 
-       /* determine switch threshold based on flags */
-      const size_t switchThreshold = (context->user && context->isCoherent()) ? 2 : switchThresholdIncoherent;
+      /* determine switch threshold based on flags and measured SIMD efficiency */
+      PacketSwitchHeuristic<K> switchHeuristic(context, 2, switchThresholdIncoherent);
 
       vint<K> octant = ray.octant();
       octant = select(valid, octant, vint<K>(0xffffffff));
@@ -211,6 +218,9 @@ namespace embree
         NodeRef* __restrict__ sptr_node = stack_node + 2;
         vfloat<K>* __restrict__ sptr_near = stack_near + 2;
 
+        /* traversal statistics of the scene */
+        TraversalCounters counters(context->scene->getStatistics());
+
         while (1) pop:
         {
           /* pop next node from stack */
@@ -237,9 +247,10 @@ namespace embree
           {
             size_t bits = movemask(active);
 #if FORCE_SINGLE_MODE == 0
-            if (unlikely(popcnt(bits) <= switchThreshold))
+            if (unlikely(popcnt(bits) <= switchHeuristic.threshold()))
 #endif
             {
+              switchHeuristic.switched();
               for (; bits!=0; ) {
                 const size_t i = bscf(bits);
                 intersect1(This, bvh, cur, i, pre, ray, tray, context);
@@ -254,6 +265,8 @@ namespace embree
             /* process nodes */
             const vbool<K> valid_node = tray.tfar > curDist;
             STAT3(normal.trav_nodes, 1, popcnt(valid_node), K);
+            counters.node(valid_node);
+            switchHeuristic.visit(valid_node);
             const NodeRef nodeRef = cur;
             const BaseNode* __restrict__ const node = nodeRef.baseNode();
 
@@ -333,7 +346,7 @@ namespace embree
             if (single)
             {
               // seems to be the best place for testing utilization
-              if (unlikely(popcnt(tray.tfar > curDist) <= switchThreshold))
+              if (unlikely(popcnt(tray.tfar > curDist) <= switchHeuristic.threshold()))
               {
                 *sptr_node++ = cur;
                 *sptr_near++ = curDist;
@@ -355,6 +368,7 @@ namespace embree
           STAT3(normal.trav_leaves, 1, popcnt(valid_leaf), K);
           if (unlikely(none(valid_leaf))) continue;
           size_t items; const Primitive* prim = (Primitive*)cur.leaf(items);
+          counters.leaf(bvh->primTy,(const char*)prim,items,valid_leaf);
 
           size_t lazy_node = 0;
           PrimitiveIntersectorK::intersect(valid_leaf, This, pre, ray, context, prim, items, tray, lazy_node);
@@ -418,6 +432,9 @@ namespace embree
         stack[0].ptr  = bvh->root;
         stack[0].dist = neg_inf;
 
+        /* traversal statistics of the scene */
+        TraversalCounters counters(context->scene->getStatistics());
+
         while (1) pop:
         {
           /* pop next node from stack */
@@ -435,6 +452,7 @@ namespace embree
           {
             /* process nodes */
             //STAT3(normal.trav_nodes, 1, popcnt(valid_node), K);
+            counters.node(active);
             const NodeRef nodeRef = cur;
             const AABBNode* __restrict__ const node = nodeRef.getAABBNode();
 
@@ -506,6 +524,7 @@ namespace embree
           STAT3(normal.trav_leaves, 1, popcnt(valid_leaf), K);
           if (unlikely(none(valid_leaf))) continue;
           size_t items; const Primitive* prim = (Primitive*)cur.leaf(items);
+          counters.leaf(bvh->primTy,(const char*)prim,items,valid_leaf);
 
           size_t lazy_node = 0;
           PrimitiveIntersectorK::intersect(valid_leaf, This, pre, ray, context, prim, items, tray, lazy_node);
@@ -551,6 +570,9 @@ namespace embree
         TravRay<N,robust> tray1;
         tray1.template init<K>(k, tray.org, tray.dir, tray.rdir, tray.nearXYZ, tray.tnear[k], tray.tfar[k]);
 
+        /* traversal statistics of the scene */
+        TraversalCounters counters(context->scene->getStatistics());
+
 	/* pop loop */
 	while (true) pop:
 	{
@@ -567,6 +589,7 @@ namespace embree
             STAT3(shadow.trav_nodes, 1, 1, 1);
             bool nodeIntersected = BVHNNodeIntersector1<N, types, robust>::intersect(cur, tray1, ray.time()[k], tNear, mask);
             if (unlikely(!nodeIntersected)) { STAT3(shadow.trav_nodes,-1,-1,-1); break; }
+            counters.node();
 
             /* if no child is hit, pop next node */
             if (unlikely(mask == 0))
@@ -580,6 +603,7 @@ namespace embree
           assert(cur != BVH::emptyNode);
           STAT3(shadow.trav_leaves, 1, 1, 1);
           size_t num; Primitive* prim = (Primitive*)cur.leaf(num);
+          counters.leaf(bvh->primTy,(const char*)prim,num);
 
           size_t lazy_node = 0;
           if (PrimitiveIntersectorK::occluded(This, pre, ray, k, context, prim, num, tray1, lazy_node)) {
@@ -643,8 +667,8 @@ namespace embree
       vbool<K> terminated = !valid;
       const vfloat<K> inf = vfloat<K>(pos_inf);
 
-      /* determine switch threshold based on flags */
-      const size_t switchThreshold = (context->user && context->isCoherent()) ? 2 : switchThresholdIncoherent;
+      /* determine switch threshold based on flags and measured SIMD efficiency */
+      PacketSwitchHeuristic<K> switchHeuristic(context, 2, switchThresholdIncoherent);
 
       /* allocate stack and push root node */
       vfloat<K> stack_near[stackSizeChunk];
@@ -657,6 +681,9 @@ namespace embree
       NodeRef* __restrict__ sptr_node = stack_node + 2;
       vfloat<K>* __restrict__ sptr_near = stack_near + 2;
 
+      /* traversal statistics of the scene */
+      TraversalCounters counters(context->scene->getStatistics());
+
       while (1) pop:
       {
         /* pop next node from stack */
@@ -683,9 +710,10 @@ namespace embree
         {
           size_t bits = movemask(active);
 #if FORCE_SINGLE_MODE == 0
-          if (unlikely(popcnt(bits) <= switchThreshold)) 
+          if (unlikely(popcnt(bits) <= switchHeuristic.threshold())) 
 #endif
           {
+            switchHeuristic.switched();
             for (; bits!=0; ) {
               const size_t i = bscf(bits);
               if (occluded1(This, bvh, cur, i, pre, ray, tray, context))
@@ -703,6 +731,8 @@ namespace embree
           /* process nodes */
           const vbool<K> valid_node = tray.tfar > curDist;
           STAT3(shadow.trav_nodes, 1, popcnt(valid_node), K);
+          counters.node(valid_node);
+          switchHeuristic.visit(valid_node);
           const NodeRef nodeRef = cur;
           const BaseNode* __restrict__ const node = nodeRef.baseNode();
 
@@ -741,7 +771,7 @@ namespace embree
           if (single)
           {
             // seems to be the best place for testing utilization
-            if (unlikely(popcnt(tray.tfar > curDist) <= switchThreshold))
+            if (unlikely(popcnt(tray.tfar > curDist) <= switchHeuristic.threshold()))
             {
               *sptr_node++ = cur;
               *sptr_near++ = curDist;
@@ -764,6 +794,7 @@ namespace embree
         STAT3(shadow.trav_leaves, 1, popcnt(valid_leaf), K);
         if (unlikely(none(valid_leaf))) continue;
         size_t items; const Primitive* prim = (Primitive*) cur.leaf(items);
+        counters.leaf(bvh->primTy,(const char*)prim,items,valid_leaf);
 
         size_t lazy_node = 0;
         terminated |= PrimitiveIntersectorK::occluded(!terminated, This, pre, ray, context, prim, items, tray, lazy_node);
@@ -831,6 +862,9 @@ namespace embree
         stack[0].ptr  = bvh->root;
         stack[0].mask = movemask(octant_valid);
 
+        /* traversal statistics of the scene */
+        TraversalCounters counters(context->scene->getStatistics());
+
         while (1) pop:
         {
           /* pop next node from stack */
@@ -848,6 +882,7 @@ namespace embree
           {
             /* process nodes */
             //STAT3(normal.trav_nodes, 1, popcnt(valid_node), K);
+            counters.node(m_active);
             const NodeRef nodeRef = cur;
             const AABBNode* __restrict__ const node = nodeRef.getAABBNode();
 
@@ -897,6 +932,7 @@ namespace embree
 #endif
           if (unlikely(!m_active)) continue;
           size_t items; const Primitive* prim = (Primitive*)cur.leaf(items);
+          counters.leaf(bvh->primTy,(const char*)prim,items,m_active);
 
           size_t lazy_node = 0;
           terminated |= PrimitiveIntersectorK::occluded(!terminated, This, pre, ray, context, prim, items, tray, lazy_node);
@@ -15,6 +15,73 @@ namespace embree
     template<int K, bool robust>
     struct TravRayK;
 
+    /*! Determines when a packet switches to single ray traversal. In
+     *  adaptive mode the threshold is interpolated between the coherent
+     *  and incoherent threshold using the average fraction of active rays
+     *  per node visit measured so far for the packet. */
+    template<int K>
+    struct PacketSwitchHeuristic
+    {
+      __forceinline PacketSwitchHeuristic (IntersectContext* context, size_t coherentThreshold, size_t incoherentThreshold)
+        : device(context->scene->device), nodeVisits(0), activeLanes(0), switches(0)
+      {
+        adaptive = device->packet_switch_adaptive;
+        statistics = device->packet_statistics;
+        enabled = adaptive || statistics;
+
+        /* a user specified threshold replaces the built-in incoherent threshold */
+        if (device->packet_switch_threshold >= 0)
+          incoherentThreshold = min(size_t(device->packet_switch_threshold),size_t(K));
+
+        minThreshold = min(coherentThreshold,incoherentThreshold);
+        maxThreshold = incoherentThreshold;
+        staticThreshold = (context->user && context->isCoherent()) ? minThreshold : maxThreshold;
+      }
+
+      __forceinline ~PacketSwitchHeuristic()
+      {
+        if (unlikely(statistics))
+          device->packetStats.add(1,nodeVisits,activeLanes,switches);
+      }
+
+      /*! records an inner node visit */
+      __forceinline void visit(const vbool<K>& active)
+      {
+        if (unlikely(enabled)) {
+          nodeVisits++;
+          activeLanes += popcnt(active);
+        }
+      }
+
+      /*! records a switch to single ray traversal */
+      __forceinline void switched() {
+        if (unlikely(enabled)) switches++;
+      }
+
+      /*! returns the number of active rays at which the packet switches to single ray traversal */
+      __forceinline size_t threshold() const
+      {
+        if (likely(!adaptive) || nodeVisits == 0)
+          return staticThreshold;
+
+        /* low SIMD efficiency switches early, high SIMD efficiency stays in packet mode */
+        const size_t totalLanes = K*nodeVisits;
+        return minThreshold + (maxThreshold-minThreshold)*(totalLanes-activeLanes)/totalLanes;
+      }
+
+    private:
+      Device* device;
+      bool enabled;            //!< true if node visits get counted
+      bool adaptive;           //!< true if threshold adapts to measured SIMD efficiency
+      bool statistics;         //!< true if counters get accumulated in device
+      size_t minThreshold;     //!< threshold for perfectly coherent packets
+      size_t maxThreshold;     //!< threshold for incoherent packets
+      size_t staticThreshold;  //!< threshold used in non-adaptive mode
+      size_t nodeVisits;       //!< number of inner node visits of this packet
+      size_t activeLanes;      //!< sum of active rays over all inner node visits
+      size_t switches;         //!< number of switches to single ray traversal
+    };
+
     /*! BVH hybrid packet intersector. Switches between packet and single ray traversal (optional). */
     template<int N, int K, int types, bool robust, typename PrimitiveIntersectorK, bool single = true>
     class BVHNIntersectorKHybrid
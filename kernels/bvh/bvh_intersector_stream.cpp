@@ -42,7 +42,54 @@ namespace embree
       
       // Only the coherent code path is implemented
       assert(context->isCoherent());
-      intersectCoherent(This, (RayHitK<VSIZEL>**)inputPackets, numOctantRays, context);
+
+      /* large tiles first cull against the top of the tree */
+      if (unlikely(numOctantRays > MAX_INTERNAL_STREAM_SIZE))
+        intersectTile(This, (RayHitK<VSIZEL>**)inputPackets, numOctantRays, bvh->root, context);
+      else
+        intersectCoherent(This, (RayHitK<VSIZEL>**)inputPackets, numOctantRays, bvh->root, context);
+    }
+
+    template<int N, int types, bool robust, typename PrimitiveIntersector>
+    template<int K>
+    __noinline void BVHNIntersectorStream<N, types, robust, PrimitiveIntersector>::intersectTile(Accel::Intersectors* __restrict__ This,
+                                                                                                 RayHitK<K>** inputPackets,
+                                                                                                 size_t numRays,
+                                                                                                 NodeRef root,
+                                                                                                 IntersectContext* context)
+    {
+      __aligned(64) Frustum<robust> frustum;
+      bool commonOctant = true;
+      if (unlikely(!initTileFrustum((RayK<K>**)inputPackets, numRays, frustum, commonOctant)))
+        return;
+
+      /* descend with the frustum of the whole tile as long as it enters a single child only */
+      NodeRef cur = root;
+      if (likely(commonOctant))
+      {
+        while (!cur.isLeaf())
+        {
+          STAT3(normal.trav_nodes, 1, 1, 1);
+          const AABBNode* __restrict__ const node = cur.getAABBNode();
+          vfloat<N> dist;
+          const size_t m_node_hit = intersectNodeFrustum<N>(node, frustum, dist);
+          if (unlikely(m_node_hit == 0)) return;
+          if (m_node_hit & (m_node_hit-1)) break; // more than one child hit
+          cur = node->child(bsf(m_node_hit));
+        }
+      }
+
+      /* small enough tiles continue with coherent stream traversal */
+      if (numRays <= MAX_INTERNAL_STREAM_SIZE) {
+        intersectCoherent(This, inputPackets, numRays, cur, context);
+        return;
+      }
+
+      /* otherwise split the tile and continue with tighter sub-frusta */
+      const size_t numPackets = (numRays+K-1)/K;
+      const size_t numRays0 = min(numRays, ((numPackets+1)/2)*K);
+      intersectTile(This, inputPackets, numRays0, cur, context);
+      intersectTile(This, inputPackets+numRays0/K, numRays-numRays0, cur, context);
     }
 
     template<int N, int types, bool robust, typename PrimitiveIntersector>
@@ -50,11 +97,11 @@ namespace embree
     __forceinline void BVHNIntersectorStream<N, types, robust, PrimitiveIntersector>::intersectCoherent(Accel::Intersectors* __restrict__ This,
                                                                                                             RayHitK<K>** inputPackets,
                                                                                                             size_t numOctantRays,
+                                                                                                            NodeRef root,
                                                                                                             IntersectContext* context)
     {
       assert(context->isCoherent());
 
-      BVH* __restrict__ bvh = (BVH*) This->ptr;
       __aligned(64) StackItemMaskCoherent stack[stackSizeSingle];  // stack of nodes
       assert(numOctantRays <= MAX_INTERNAL_STREAM_SIZE);
 
@@ -74,9 +121,21 @@ namespace embree
         return;
       }
 
+      STAT3(normal.trav_stream_rays, 1, popcnt(m_active), numOctantRays);
+
+      /* traversal statistics of the scene */
+      const BVH* __restrict__ bvh = (const BVH*)This->ptr;
+      TraversalCounters counters(context->scene->getStatistics());
+
+      /* optionally order children by the entry distance of the central ray instead of the frustum distance */
+      const bool averageOrder = context->scene->device->stream_average_order;
+      Vec3fa central_org, central_rdir;
+      if (unlikely(averageOrder))
+        initCentralRay((RayK<K>**)inputPackets, m_active, central_org, central_rdir);
+
       stack[0].mask   = m_active;
       stack[0].parent = 0;
-      stack[0].child  = bvh->root;
+      stack[0].child  = root;
 
       ///////////////////////////////////////////////////////////////////////////////////
       ///////////////////////////////////////////////////////////////////////////////////
@@ -105,10 +164,15 @@ namespace embree
           __aligned(64) size_t maskK[N];
           for (size_t i = 0; i < N; i++)
             maskK[i] = m_trav_active;
+          STAT3(normal.trav_stream_nodes, 1, popcnt(m_trav_active), numOctantRays);
+          counters.node(m_trav_active);
           vfloat<N> dist;
           const size_t m_node_hit = traverseCoherentStream(m_trav_active, packets, node, frustum, maskK, dist);
           if (unlikely(m_node_hit == 0)) goto pop;
 
+          if (unlikely(averageOrder))
+            dist = max(dist, centralEntryDistance(node, frustum.nf, central_org, central_rdir));
+
           BVHNNodeTraverserStreamHitCoherent<N, types>::traverseClosestHit(cur, m_trav_active, vbool<N>((int)m_node_hit), dist, (size_t*)maskK, stackPtr);
           assert(m_trav_active);
         }
@@ -131,6 +195,7 @@ namespace embree
         size_t num; PrimitiveK<K>* prim = (PrimitiveK<K>*)cur.leaf(num);
 
         size_t bits = m_trav_active;
+        counters.leaf(bvh->primTy,(const char*)prim,num,bits);
 
         /*! intersect stream of rays with all primitives */
         size_t lazy_node = 0;
@@ -202,6 +267,9 @@ namespace embree
         return;
       }
 
+      /* traversal statistics of the scene */
+      TraversalCounters counters(context->scene->getStatistics());
+
       stack[0].mask   = m_active;
       stack[0].parent = 0;
       stack[0].child  = bvh->root;
@@ -234,6 +302,7 @@ namespace embree
           __aligned(64) size_t maskK[N];
           for (size_t i = 0; i < N; i++)
             maskK[i] = m_trav_active;
+          counters.node(m_trav_active);
 
           vfloat<N> dist;
           const size_t m_node_hit = traverseCoherentStream(m_trav_active, packets, node, frustum, maskK, dist);
@@ -261,6 +330,7 @@ namespace embree
         size_t num; PrimitiveK<K>* prim = (PrimitiveK<K>*)cur.leaf(num);
 
         size_t bits = m_trav_active & m_active;
+        counters.leaf(bvh->primTy,(const char*)prim,num,bits);
         /*! intersect stream of rays with all primitives */
         size_t lazy_node = 0;
 #if defined(__SSE4_2__)
@@ -320,6 +390,9 @@ namespace embree
 
       size_t terminated = ~m_active;
 
+      /* traversal statistics of the scene */
+      TraversalCounters counters(context->scene->getStatistics());
+
       /* near/far offsets based on first ray */
       const NearFarPrecalculations nf(Vec3fa(packet[0].rdir.x[0], packet[0].rdir.y[0], packet[0].rdir.z[0]), N);
 
@@ -337,6 +410,7 @@ namespace embree
           /*! stop if we found a leaf node */
           if (unlikely(cur.isLeaf())) break;
           const AABBNode* __restrict__ const node = cur.getAABBNode();
+          counters.node(cur_mask);
 
           const vint<N> vmask = traverseIncoherentStream(cur_mask, packet, node, nf, shiftTable);
 
@@ -382,6 +456,7 @@ namespace embree
         size_t num; PrimitiveK<K>* prim = (PrimitiveK<K>*)cur.leaf(num);
 
         size_t bits = cur_mask;
+        counters.leaf(bvh->primTy,(const char*)prim,num,bits);
         size_t lazy_node = 0;
 
         for (; bits != 0;)
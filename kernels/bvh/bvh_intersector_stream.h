@@ -101,6 +101,93 @@ namespace embree
         return m_active;
       }
 
+      template<int K>
+      __forceinline static bool initTileFrustum(RayK<K>** inputPackets, size_t numRays, Frustum<robust>& frustum, bool& commonOctant)
+      {
+        const size_t numPackets = (numRays+K-1)/K;
+
+        Vec3vf<K> tmp_min_rdir(pos_inf);
+        Vec3vf<K> tmp_max_rdir(neg_inf);
+        Vec3vf<K> tmp_min_org(pos_inf);
+        Vec3vf<K> tmp_max_org(neg_inf);
+        vfloat<K> tmp_min_dist(pos_inf);
+        vfloat<K> tmp_max_dist(neg_inf);
+
+        bool active = false;
+        for (size_t i = 0; i < numPackets; i++)
+        {
+          const vfloat<K> tnear = inputPackets[i]->tnear();
+          const vfloat<K> tfar  = inputPackets[i]->tfar;
+          vbool<K> m_valid = (tnear <= tfar) & (tnear >= 0.0f);
+          m_valid &= vint<K>(int(i*K)) + vint<K>(step) < vint<K>(int(numRays));
+
+#if defined(EMBREE_IGNORE_INVALID_RAYS)
+          m_valid &= inputPackets[i]->valid();
+#endif
+          active |= any(m_valid);
+
+          const Vec3vf<K>& org = inputPackets[i]->org;
+          const Vec3vf<K> rdir = rcp_safe(inputPackets[i]->dir);
+          tmp_min_dist = min(tmp_min_dist, select(m_valid, max(tnear, 0.0f), pos_inf));
+          tmp_max_dist = max(tmp_max_dist, select(m_valid, tfar, neg_inf));
+          tmp_min_rdir = min(tmp_min_rdir, select(m_valid, rdir, Vec3vf<K>(pos_inf)));
+          tmp_max_rdir = max(tmp_max_rdir, select(m_valid, rdir, Vec3vf<K>(neg_inf)));
+          tmp_min_org  = min(tmp_min_org , select(m_valid, org , Vec3vf<K>(pos_inf)));
+          tmp_max_org  = max(tmp_max_org , select(m_valid, org , Vec3vf<K>(neg_inf)));
+        }
+        if (!active) return false;
+
+        const Vec3fa reduced_min_rdir(reduce_min(tmp_min_rdir.x), reduce_min(tmp_min_rdir.y), reduce_min(tmp_min_rdir.z));
+        const Vec3fa reduced_max_rdir(reduce_max(tmp_max_rdir.x), reduce_max(tmp_max_rdir.y), reduce_max(tmp_max_rdir.z));
+        const Vec3fa reduced_min_org (reduce_min(tmp_min_org.x ), reduce_min(tmp_min_org.y ), reduce_min(tmp_min_org.z ));
+        const Vec3fa reduced_max_org (reduce_max(tmp_max_org.x ), reduce_max(tmp_max_org.y ), reduce_max(tmp_max_org.z ));
+
+        commonOctant =
+          (reduced_max_rdir.x < 0.0f || reduced_min_rdir.x >= 0.0f) &&
+          (reduced_max_rdir.y < 0.0f || reduced_min_rdir.y >= 0.0f) &&
+          (reduced_max_rdir.z < 0.0f || reduced_min_rdir.z >= 0.0f);
+
+        frustum.init(reduced_min_org, reduced_max_org,
+                     reduced_min_rdir, reduced_max_rdir,
+                     reduce_min(tmp_min_dist), reduce_max(tmp_max_dist),
+                     N);
+        return true;
+      }
+
+      template<int K>
+      __forceinline static void initCentralRay(RayK<K>** inputPackets, size_t m_active, Vec3fa& central_org, Vec3fa& central_rdir)
+      {
+        const size_t numPackets = (bsr(m_active)+K)/K;
+
+        Vec3vf<K> sum_org(zero);
+        Vec3vf<K> sum_dir(zero);
+        vfloat<K> sum_rays(zero);
+        for (size_t i = 0; i < numPackets; i++)
+        {
+          const vbool<K> m_valid((int)((m_active >> (i*K)) & (((size_t)1 << K)-1)));
+          sum_org  += select(m_valid, inputPackets[i]->org, Vec3vf<K>(zero));
+          sum_dir  += select(m_valid, inputPackets[i]->dir, Vec3vf<K>(zero));
+          sum_rays += select(m_valid, vfloat<K>(one), vfloat<K>(zero));
+        }
+
+        const float rcp_rays = rcp(reduce_add(sum_rays));
+        central_org  = rcp_rays*Vec3fa(reduce_add(sum_org.x), reduce_add(sum_org.y), reduce_add(sum_org.z));
+        central_rdir = rcp_safe(rcp_rays*Vec3fa(reduce_add(sum_dir.x), reduce_add(sum_dir.y), reduce_add(sum_dir.z)));
+      }
+
+      /* entry distance of the central ray into each child, approximates the average entry distance of all active rays */
+      __forceinline static vfloat<N> centralEntryDistance(const AABBNode* __restrict__ node, const NearFarPrecalculations& nf,
+                                                          const Vec3fa& central_org, const Vec3fa& central_rdir)
+      {
+        const vfloat<N> bminX = *(const vfloat<N>*)((const char*)&node->lower_x + nf.nearX);
+        const vfloat<N> bminY = *(const vfloat<N>*)((const char*)&node->lower_x + nf.nearY);
+        const vfloat<N> bminZ = *(const vfloat<N>*)((const char*)&node->lower_x + nf.nearZ);
+        const vfloat<N> tNearX = (bminX - vfloat<N>(central_org.x)) * vfloat<N>(central_rdir.x);
+        const vfloat<N> tNearY = (bminY - vfloat<N>(central_org.y)) * vfloat<N>(central_rdir.y);
+        const vfloat<N> tNearZ = (bminZ - vfloat<N>(central_org.z)) * vfloat<N>(central_rdir.z);
+        return max(tNearX, tNearY, tNearZ);
+      }
+
       template<int K>
       __forceinline static size_t intersectAABBNodePacket(size_t m_active,
                                                              const TravRayKStream<K,robust>* packets,
@@ -252,7 +339,10 @@ namespace embree
 
     private:
       template<int K>
-      static void intersectCoherent(Accel::Intersectors* This, RayHitK<K>** inputRays, size_t numRays, IntersectContext* context);
+      static void intersectCoherent(Accel::Intersectors* This, RayHitK<K>** inputRays, size_t numRays, NodeRef root, IntersectContext* context);
+
+      template<int K>
+      static void intersectTile(Accel::Intersectors* This, RayHitK<K>** inputRays, size_t numRays, NodeRef root, IntersectContext* context);
 
       template<int K>
       static void occludedCoherent(Accel::Intersectors* This, RayK<K>** inputRays, size_t numRays, IntersectContext* context);
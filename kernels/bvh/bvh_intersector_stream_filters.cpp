@@ -447,6 +447,35 @@ namespace embree
       }
     }
 
+    template<int K>
+    __noinline void RayStreamFilter::filterTile(Scene* scene, RTCRayHit16* tile, size_t numPackets, IntersectContext* context)
+    {
+      const size_t numRays = 16*numPackets;
+      assert(numRays <= MAX_INTERNAL_TILE_SIZE);
+
+      __aligned(64) RayHitK<K> rays[MAX_INTERNAL_TILE_SIZE / K];
+      __aligned(64) RayHitK<K>* rayPtrs[MAX_INTERNAL_TILE_SIZE / K];
+
+      /* convert from 16 wide packets to native packets */
+      const vbool<K> valid(true);
+      for (size_t i = 0; i < numRays; i += K)
+      {
+        RayStreamSOA rayN((char*)&tile[i/16], 16);
+        rays[i/K] = rayN.getRayByOffset<K>(valid, (i%16)*sizeof(float));
+        rayPtrs[i/K] = &rays[i/K];
+      }
+
+      /* trace whole tile as one stream */
+      scene->intersectors.intersectN(rayPtrs, numRays, context);
+
+      /* convert back to 16 wide packets */
+      for (size_t i = 0; i < numRays; i += K)
+      {
+        RayStreamSOA rayN((char*)&tile[i/16], 16);
+        rayN.setHitByOffset(valid, (i%16)*sizeof(float), rays[i/K]);
+      }
+    }
+
     template<int K, bool intersect>
     __noinline void RayStreamFilter::filterSOP(Scene* scene, const void* _rayN, size_t N, IntersectContext* context)
     { 
@@ -591,6 +620,89 @@ namespace embree
       }
     }
 
+    /* Tests a stream of rays for occlusion by tracing segments of each
+     * ray as packets. Rays are kept in a small pool, after each round
+     * occluded rays and rays that finished their last segment leave the
+     * pool, and the surviving rays are packed together with new rays
+     * into full packets for the next round. Segments get longer towards
+     * the end of the ray, as most occluders are found close to the origin. */
+    template<int K, typename GetRay, typename SetOccluded>
+    __noinline void RayStreamFilter::occludedCompact(Scene* scene, size_t N, const GetRay& getRay, const SetOccluded& setOccluded, IntersectContext* context)
+    {
+      static const size_t POOL_SIZE = MAX_INTERNAL_STREAM_SIZE;
+      static const unsigned int NUM_SEGMENTS = 3;
+      static const float segmentStart[NUM_SEGMENTS+1] = { 0.0f, 1.0f/7.0f, 3.0f/7.0f, 1.0f };
+
+      __aligned(64) Ray pool[POOL_SIZE];
+      unsigned int poolRayID[POOL_SIZE];
+      unsigned int poolSegment[POOL_SIZE];
+      bool poolOccluded[POOL_SIZE];
+      size_t poolSize = 0;
+      size_t inputRayID = 0;
+
+      for (;;)
+      {
+        /* fill pool with new rays */
+        for (; poolSize < POOL_SIZE && inputRayID < N; inputRayID++)
+        {
+          const Ray ray = getRay(inputRayID);
+          if (unlikely(ray.tnear() > ray.tfar || ray.tfar < 0.0f)) continue; // ignore invalid or already occluded rays
+#if defined(EMBREE_IGNORE_INVALID_RAYS)
+          if (unlikely(!ray.valid())) continue;
+#endif
+          pool[poolSize] = ray;
+          poolRayID[poolSize] = (unsigned int)inputRayID;
+          poolSegment[poolSize] = ray.tfar == float(inf) ? NUM_SEGMENTS-1 : 0; // infinite rays are traced as a single segment
+          poolSize++;
+        }
+
+        /* all rays traced? */
+        if (unlikely(poolSize == 0))
+          break;
+
+        /* trace current segment of all rays in full packets */
+        for (size_t j = 0; j < poolSize; j += K)
+        {
+          const size_t num = min(poolSize-j,size_t(K));
+          const vbool<K> valid = vint<K>(step) < vint<K>(int(num));
+
+          RayK<K> packet;
+          for (size_t k = 0; k < K; k++)
+          {
+            const size_t i = j + min(k,num-1); // inactive lanes duplicate a valid ray
+            const unsigned int segment = poolSegment[i];
+            const float tnear = pool[i].tnear(), tfar = pool[i].tfar;
+            Ray ray = pool[i];
+            ray.tnear() = (segment == 0 || tfar == float(inf)) ? tnear : madd(tfar-tnear,segmentStart[segment],tnear);
+            ray.tfar = segment == NUM_SEGMENTS-1 ? tfar : madd(tfar-tnear,segmentStart[segment+1],tnear);
+            packet.set(k,ray);
+          }
+
+          scene->intersectors.occluded(valid, packet, context);
+
+          for (size_t k = 0; k < num; k++)
+            poolOccluded[j+k] = packet.tfar[k] < 0.0f;
+        }
+
+        /* retire finished rays and compact the pool */
+        size_t numActive = 0;
+        for (size_t i = 0; i < poolSize; i++)
+        {
+          if (poolOccluded[i]) {
+            setOccluded(poolRayID[i]);
+            continue;
+          }
+          if (++poolSegment[i] == NUM_SEGMENTS)
+            continue;
+
+          pool[numActive] = pool[i];
+          poolRayID[numActive] = poolRayID[i];
+          poolSegment[numActive] = poolSegment[i];
+          numActive++;
+        }
+        poolSize = numActive;
+      }
+    }
 
     void RayStreamFilter::intersectAOS(Scene* scene, RTCRayHit* _rayN, size_t N, size_t stride, IntersectContext* context) {
       if (unlikely(context->isCoherent()))
@@ -600,7 +712,14 @@ namespace embree
     }
 
     void RayStreamFilter::occludedAOS(Scene* scene, RTCRay* _rayN, size_t N, size_t stride, IntersectContext* context) {
-      if (unlikely(context->isCoherent()))
+      if (unlikely(context->isCompact())) {
+        RayStreamAOS rayN(_rayN);
+        occludedCompact<VSIZEX>(scene, N,
+                                [&] (size_t i) -> Ray { return rayN.getRayByOffset(i*stride); },
+                                [&] (size_t i) { rayN.getRayByOffset(i*stride).tfar = neg_inf; },
+                                context);
+      }
+      else if (unlikely(context->isCoherent()))
         filterAOS<VSIZEL, false>(scene, _rayN, N, stride, context);
       else
         filterAOS<VSIZEX, false>(scene, _rayN, N, stride, context);
@@ -614,7 +733,14 @@ namespace embree
     }
 
     void RayStreamFilter::occludedAOP(Scene* scene, RTCRay** _rayN, size_t N, IntersectContext* context) {
-      if (unlikely(context->isCoherent()))
+      if (unlikely(context->isCompact())) {
+        RayStreamAOP rayN((void**)_rayN);
+        occludedCompact<VSIZEX>(scene, N,
+                                [&] (size_t i) -> Ray { return rayN.getRayByIndex(i); },
+                                [&] (size_t i) { rayN.getRayByIndex(i).tfar = neg_inf; },
+                                context);
+      }
+      else if (unlikely(context->isCoherent()))
         filterAOP<VSIZEL, false>(scene, (void**)_rayN, N, context);
       else
         filterAOP<VSIZEX, false>(scene, (void**)_rayN, N, context);
@@ -628,7 +754,13 @@ namespace embree
     }
 
     void RayStreamFilter::occludedSOA(Scene* scene, char* rayData, size_t N, size_t numPackets, size_t stride, IntersectContext* context) {
-      if (unlikely(context->isCoherent()))
+      if (unlikely(context->isCompact())) {
+        occludedCompact<VSIZEX>(scene, N*numPackets,
+                                [&] (size_t i) -> Ray { return RayStreamSOA(rayData + (i/N)*stride, N).getRayByOffset((i%N)*sizeof(float)); },
+                                [&] (size_t i) { *RayStreamSOA(rayData + (i/N)*stride, N).tfar((i%N)*sizeof(float)) = neg_inf; },
+                                context);
+      }
+      else if (unlikely(context->isCoherent()))
         filterSOA<VSIZEL, false>(scene, rayData, N, numPackets, stride, context);
       else
         filterSOA<VSIZEX, false>(scene, rayData, N, numPackets, stride, context);
@@ -641,8 +773,22 @@ namespace embree
         filterSOP<VSIZEX, true>(scene, _rayN, N, context);
     }
 
+    void RayStreamFilter::intersectTile(Scene* scene, RTCRayHit16* tile, size_t numPackets, IntersectContext* context) {
+      if (likely(context->isCoherent()))
+        filterTile<VSIZEL>(scene, tile, numPackets, context);
+      else
+        filterSOA<VSIZEX, true>(scene, (char*)tile, 16, numPackets, sizeof(RTCRayHit16), context);
+    }
+
     void RayStreamFilter::occludedSOP(Scene* scene, const RTCRayNp* _rayN, size_t N, IntersectContext* context) {
-      if (unlikely(context->isCoherent()))
+      if (unlikely(context->isCompact())) {
+        RayStreamSOP& rayN = *(RayStreamSOP*)_rayN;
+        occludedCompact<VSIZEX>(scene, N,
+                                [&] (size_t i) -> Ray { return rayN.getRayByOffset(i*sizeof(float)); },
+                                [&] (size_t i) { rayN.tfar[i] = neg_inf; },
+                                context);
+      }
+      else if (unlikely(context->isCoherent()))
         filterSOP<VSIZEL, false>(scene, _rayN, N, context);
       else
         filterSOP<VSIZEX, false>(scene, _rayN, N, context);
@@ -650,7 +796,7 @@ namespace embree
 
 
     RayStreamFilterFuncs rayStreamFilterFuncs() {
-      return RayStreamFilterFuncs(RayStreamFilter::intersectAOS, RayStreamFilter::intersectAOP, RayStreamFilter::intersectSOA, RayStreamFilter::intersectSOP,
+      return RayStreamFilterFuncs(RayStreamFilter::intersectAOS, RayStreamFilter::intersectAOP, RayStreamFilter::intersectSOA, RayStreamFilter::intersectSOP, RayStreamFilter::intersectTile,
                                   RayStreamFilter::occludedAOS,  RayStreamFilter::occludedAOP,  RayStreamFilter::occludedSOA,  RayStreamFilter::occludedSOP);
     }
   };
@@ -18,6 +18,7 @@ namespace embree
       static void intersectAOP(Scene* scene, RTCRayHit** rays, size_t N, IntersectContext* context);
       static void intersectSOA(Scene* scene, char* rays, size_t N, size_t numPackets, size_t stride, IntersectContext* context);
       static void intersectSOP(Scene* scene, const RTCRayHitNp* rays, size_t N, IntersectContext* context);
+      static void intersectTile(Scene* scene, RTCRayHit16* tile, size_t numPackets, IntersectContext* context);
 
       static void occludedAOS(Scene* scene, RTCRay* rays, size_t N, size_t stride, IntersectContext* context);
       static void occludedAOP(Scene* scene, RTCRay** rays, size_t N, IntersectContext* context);
@@ -36,6 +37,12 @@ namespace embree
 
       template<int K, bool intersect>
       static void filterSOP(Scene* scene, const void* rays, size_t N, IntersectContext* context);
+
+      template<int K>
+      static void filterTile(Scene* scene, RTCRayHit16* tile, size_t numPackets, IntersectContext* context);
+
+      template<int K, typename GetRay, typename SetOccluded>
+      static void occludedCompact(Scene* scene, size_t N, const GetRay& getRay, const SetOccluded& setOccluded, IntersectContext* context);
     };
   }
 };
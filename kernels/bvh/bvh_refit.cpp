@@ -28,99 +28,97 @@ namespace embree
 
     template<int N>
     BVHNRefitter<N>::BVHNRefitter (BVH* bvh, const LeafBoundsInterface& leafBounds)
-      : bvh(bvh), leafBounds(leafBounds), numSubTrees(0)
+      : bvh(bvh), leafBounds(leafBounds), linked(false)
     {
     }
 
     template<int N>
     void BVHNRefitter<N>::refit()
     {
-      if (bvh->numPrimitives <= SINGLE_THREAD_THRESHOLD) {
+      if (bvh->numPrimitives <= SINGLE_THREAD_THRESHOLD || !bvh->root.isAABBNode()) {
         bvh->bounds = LBBox3fa(recurse_bottom(bvh->root));
       }
       else
       {
-        BBox3fa subTreeBounds[MAX_NUM_SUB_TREES];
-        numSubTrees = 0;
-        gather_subtree_refs(bvh->root,numSubTrees,0);
-        if (numSubTrees)
-          parallel_for(size_t(0), numSubTrees, size_t(1), [&](const range<size_t>& r) {
-              for (size_t i=r.begin(); i<r.end(); i++) {
-                NodeRef& ref = subTrees[i];
-                subTreeBounds[i] = recurse_bottom(ref);
-              }
-            });
-
-        numSubTrees = 0;        
-        bvh->bounds = LBBox3fa(refit_toplevel(bvh->root,numSubTrees,subTreeBounds,0));
-      }    
-  }
+        /* link all nodes to their parents once after each rebuild */
+        if (!linked)
+        {
+          nodeLinks.clear();
+          leafLinks.clear();
+          link_nodes(bvh->root,INVALID_PARENT,0);
+          arrived.reset(new std::atomic<unsigned int>[nodeLinks.size()]);
+          for (size_t i=0; i<nodeLinks.size(); i++)
+            arrived[i].store(0);
+          linked = true;
+        }
+        refit_bottom_up();
+      }
+    }
 
     template<int N>
-    void BVHNRefitter<N>::gather_subtree_refs(NodeRef& ref,
-                                              size_t &subtrees,
-                                              const size_t depth)
+    void BVHNRefitter<N>::link_nodes(NodeRef ref, unsigned int parent, unsigned int slot)
     {
-      if (depth >= MAX_SUB_TREE_EXTRACTION_DEPTH) 
-      {
-        assert(subtrees < MAX_NUM_SUB_TREES);
-        subTrees[subtrees++] = ref;
-        return;
-      }
-
       if (ref.isAABBNode())
       {
+        const unsigned int index = (unsigned int) nodeLinks.size();
         AABBNode* node = ref.getAABBNode();
+        NodeLink link;
+        link.node = node;
+        link.parent = parent;
+        link.slot = slot;
+        link.numChildren = 0;
+        nodeLinks.push_back(link);
+
         for (size_t i=0; i<N; i++) {
-          NodeRef& child = node->child(i);
+          NodeRef child = node->child(i);
           if (unlikely(child == BVH::emptyNode)) continue;
-          gather_subtree_refs(child,subtrees,depth+1); 
+          nodeLinks[index].numChildren++;
+          link_nodes(child,index,(unsigned int)i);
         }
       }
+      else
+      {
+        LeafLink link;
+        link.ref = ref;
+        link.parent = parent;
+        link.slot = slot;
+        leafLinks.push_back(link);
+      }
     }
 
     template<int N>
-    BBox3fa BVHNRefitter<N>::refit_toplevel(NodeRef& ref,
-                                            size_t &subtrees,
-											const BBox3fa *const subTreeBounds,
-                                            const size_t depth)
+    void BVHNRefitter<N>::refit_bottom_up()
     {
-      if (depth >= MAX_SUB_TREE_EXTRACTION_DEPTH) 
+      BBox3fa rootBounds = empty;
+      parallel_for(size_t(0), leafLinks.size(), size_t(64), [&](const range<size_t>& r)
       {
-        assert(subtrees < MAX_NUM_SUB_TREES);
-        assert(subTrees[subtrees] == ref);
-        return subTreeBounds[subtrees++];
-      }
-
-      if (ref.isAABBNode())
-      {
-        AABBNode* node = ref.getAABBNode();
-        BBox3fa bounds[N];
-
-        for (size_t i=0; i<N; i++)
+        for (size_t i=r.begin(); i<r.end(); i++)
         {
-          NodeRef& child = node->child(i);
-
-          if (unlikely(child == BVH::emptyNode)) 
-            bounds[i] = BBox3fa(empty);
-          else
-            bounds[i] = refit_toplevel(child,subtrees,subTreeBounds,depth+1); 
+          NodeRef ref = leafLinks[i].ref;
+          BBox3fa bounds = leafBounds.leafBounds(ref);
+          unsigned int parent = leafLinks[i].parent;
+          unsigned int slot = leafLinks[i].slot;
+
+          /* propagate bounds upwards, the last child arriving at a node continues with its parent */
+          while (true)
+          {
+            const NodeLink& link = nodeLinks[parent];
+            link.node->setBounds(slot,bounds);
+            if (arrived[parent].fetch_add(1)+1 != link.numChildren)
+              break;
+
+            arrived[parent].store(0,std::memory_order_relaxed);
+            bounds = link.node->bounds();
+            if (link.parent == INVALID_PARENT) {
+              rootBounds = bounds;
+              break;
+            }
+            slot = link.slot;
+            parent = link.parent;
+          }
         }
-        
-        BBox3vf<N> boundsT = transpose<N>(bounds);
-      
-        /* set new bounds */
-        node->lower_x = boundsT.lower.x;
-        node->lower_y = boundsT.lower.y;
-        node->lower_z = boundsT.lower.z;
-        node->upper_x = boundsT.upper.x;
-        node->upper_y = boundsT.upper.y;
-        node->upper_z = boundsT.upper.z;
-        
-        return merge<N>(bounds);
-      }
-      else
-        return leafBounds.leafBounds(ref);
+      });
+      bvh->bounds = LBBox3fa(rootBounds);
     }
 
     // =========================================================
@@ -175,6 +173,7 @@ namespace embree
     {
       if (builder) 
         builder->clear();
+      refitter->invalidate();
     }
     
     template<int N, typename Mesh, typename Primitive>
@@ -183,6 +182,7 @@ namespace embree
       if (mesh->topologyChanged(topologyVersion)) {
         topologyVersion = mesh->getTopologyVersion();
         builder->build();
+        refitter->invalidate();
       }
       else
         refitter->refit();
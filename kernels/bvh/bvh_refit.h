@@ -31,17 +31,15 @@ namespace embree
       /*! refits the BVH */
       void refit();
 
+      /*! invalidates the node links, has to get called when the BVH got rebuilt */
+      void invalidate() { linked = false; }
+
     private:
-      /* single-threaded subtree extraction based on BVH depth */
-      void gather_subtree_refs(NodeRef& ref, 
-                               size_t &subtrees,
-                               const size_t depth = 0);
+      /* single-threaded linearization of the BVH storing parent links of all nodes and leaves */
+      void link_nodes(NodeRef ref, unsigned int parent, unsigned int slot);
 
-      /* single-threaded top-level refit */
-      BBox3fa refit_toplevel(NodeRef& ref,
-                             size_t &subtrees,
-							 const BBox3fa *const subTreeBounds,
-                             const size_t depth = 0);
+      /* parallel bottom-up refit from all leaves using per-node arrival counters */
+      void refit_bottom_up();
 
       /* single-threaded subtree refit */
       BBox3fa recurse_bottom(NodeRef& ref);
@@ -50,10 +48,30 @@ namespace embree
       BVH* bvh;                              //!< BVH to refit
       const LeafBoundsInterface& leafBounds; //!< calculates bounds of leaves
 
-      static const size_t MAX_SUB_TREE_EXTRACTION_DEPTH = (N==4) ? 4   : (N==8) ? 3    : 3;
-      static const size_t MAX_NUM_SUB_TREES             = (N==4) ? 256 : (N==8) ? 512 : N*N*N; // N ^ MAX_SUB_TREE_EXTRACTION_DEPTH
-      size_t numSubTrees;
-      NodeRef subTrees[MAX_NUM_SUB_TREES];
+    private:
+      static const unsigned int INVALID_PARENT = -1;
+
+      /*! inner node with link to its parent */
+      struct NodeLink
+      {
+        AABBNode* node;           //!< pointer to the inner node
+        unsigned int parent;      //!< index of parent node
+        unsigned int slot;        //!< child slot inside the parent node
+        unsigned int numChildren; //!< number of non-empty children
+      };
+
+      /*! leaf with link to its parent */
+      struct LeafLink
+      {
+        NodeRef ref;              //!< reference to the leaf
+        unsigned int parent;      //!< index of parent node
+        unsigned int slot;        //!< child slot inside the parent node
+      };
+
+      bool linked;                                          //!< true if the links are valid for the current BVH
+      std::vector<NodeLink> nodeLinks;                      //!< all inner nodes
+      std::vector<LeafLink> leafLinks;                      //!< all leaves
+      std::unique_ptr<std::atomic<unsigned int>[]> arrived; //!< number of children refitted per inner node
     };
 
     template<int N, typename Mesh, typename Primitive>
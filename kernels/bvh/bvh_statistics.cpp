@@ -131,13 +131,14 @@ namespace embree
     else if (node.isLeaf())
     {
       size_t num; const char* tri = node.leaf(num);
+      const PrimitiveType* primTy = bvh->primTy->leafType(tri,num);
       if (num)
       {
         for (size_t i=0; i<num; i++)
         {
-          const size_t bytes = bvh->primTy->getBytes(tri);
-          s.statLeaf.numPrimsActive += bvh->primTy->sizeActive(tri);
-          s.statLeaf.numPrimsTotal += bvh->primTy->sizeTotal(tri);
+          const size_t bytes = primTy->getBytes(tri);
+          s.statLeaf.numPrimsActive += primTy->sizeActive(tri);
+          s.statLeaf.numPrimsTotal += primTy->sizeTotal(tri);
           s.statLeaf.numBytes += bytes;
           tri+=bytes;
         }
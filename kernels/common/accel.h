@@ -21,7 +21,7 @@ namespace embree
 
   public:
     AccelData (const Type type) 
-      : bounds(empty), type(type) {}
+      : bounds(empty), type(type), mask(-1) {}
 
     /*! notifies the acceleration structure about the deletion of some geometry */
     virtual void deleteGeometry(size_t geomID) {};
@@ -29,6 +29,9 @@ namespace embree
     /*! clears the acceleration structure data */
     virtual void clear() = 0;
 
+    /*! returns the number of bytes allocated for the acceleration structure data */
+    virtual size_t bytesAllocated() { return 0; }
+
     /*! returns normal bounds */
     __forceinline BBox3fa getBounds() const {
       return bounds.bounds();
@@ -52,6 +55,7 @@ namespace embree
   public:
     LBBox3fa bounds; // linear bounds
     Type type;
+    unsigned int mask; //!< OR-ed ray masks of all geometries, rays outside this mask get culled
   };
 
   /*! Base class for all intersectable and buildable acceleration structures. */
@@ -62,8 +66,8 @@ namespace embree
 
     struct Intersectors;
 
-    /*! Type of collide function */
-    typedef void (*CollideFunc)(void* bvh0, void* bvh1, RTCCollideFunc callback, void* userPtr);
+    /*! Type of collide function, exactly one of the two callbacks is set */
+    typedef void (*CollideFunc)(void* bvh0, void* bvh1, RTCCollideFunc callback, RTCCollideInstancedFunc callbackInstanced, void* userPtr);
 
     /*! Type of point query function */
     typedef bool(*PointQueryFunc)(Intersectors* This,          /*!< this pointer to accel */
@@ -272,6 +276,10 @@ namespace embree
 
       void select(bool filter)
       {
+        if (intersector1_filter) {
+          if (filter) intersector1 = intersector1_filter;
+          else        intersector1 = intersector1_nofilter;
+        }
         if (intersector4_filter) {
           if (filter) intersector4 = intersector4_filter;
           else        intersector4 = intersector4_nofilter;
@@ -296,9 +304,10 @@ namespace embree
       }
 
       /*! collides two scenes */
-      __forceinline void collide (Accel* scene0, Accel* scene1, RTCCollideFunc callback, void* userPtr) {
+      __forceinline void collide (Accel* scene0, Accel* scene1, RTCCollideFunc callback, RTCCollideInstancedFunc callbackInstanced, void* userPtr) {
         assert(collider.collide);
-        collider.collide(scene0->intersectors.ptr,scene1->intersectors.ptr,callback,userPtr);
+        assert(callback == nullptr || callbackInstanced == nullptr);
+        collider.collide(scene0->intersectors.ptr,scene1->intersectors.ptr,callback,callbackInstanced,userPtr);
       }
 
       /*! Intersects a single ray with the scene. */
@@ -435,6 +444,8 @@ namespace embree
       void* leafIntersector;
       Collider collider;
       Intersector1 intersector1;
+      Intersector1 intersector1_filter;
+      Intersector1 intersector1_nofilter;
       Intersector4 intersector4;
       Intersector4 intersector4_filter;
       Intersector4 intersector4_nofilter;
@@ -519,6 +530,7 @@ namespace embree
   typedef void (*intersectStreamAOP_func)(Scene* scene, RTCRayHit** _rayN, const size_t N, IntersectContext* context);
   typedef void (*intersectStreamSOA_func)(Scene* scene, char* rayN, const size_t N, const size_t streams, const size_t stream_offset, IntersectContext* context);
   typedef void (*intersectStreamSOP_func)(Scene* scene, const RTCRayHitNp* rayN, const size_t N, IntersectContext* context);
+  typedef void (*intersectStreamTile_func)(Scene* scene, RTCRayHit16* tile, const size_t numPackets, IntersectContext* context);
 
   typedef void (*occludedStreamAOS_func)(Scene* scene, RTCRay*  _rayN, const size_t N, const size_t stride, IntersectContext* context);
   typedef void (*occludedStreamAOP_func)(Scene* scene, RTCRay** _rayN, const size_t N, IntersectContext* context);
@@ -528,16 +540,16 @@ namespace embree
   struct RayStreamFilterFuncs
   {
     RayStreamFilterFuncs()
-    : intersectAOS(nullptr), intersectAOP(nullptr), intersectSOA(nullptr), intersectSOP(nullptr),
+    : intersectAOS(nullptr), intersectAOP(nullptr), intersectSOA(nullptr), intersectSOP(nullptr), intersectTile(nullptr),
       occludedAOS(nullptr),  occludedAOP(nullptr),  occludedSOA(nullptr),  occludedSOP(nullptr) {}
 
     RayStreamFilterFuncs(void (*ptr) ())
-    : intersectAOS((intersectStreamAOS_func) ptr), intersectAOP((intersectStreamAOP_func) ptr), intersectSOA((intersectStreamSOA_func) ptr), intersectSOP((intersectStreamSOP_func) ptr),
+    : intersectAOS((intersectStreamAOS_func) ptr), intersectAOP((intersectStreamAOP_func) ptr), intersectSOA((intersectStreamSOA_func) ptr), intersectSOP((intersectStreamSOP_func) ptr), intersectTile((intersectStreamTile_func) ptr),
       occludedAOS((occludedStreamAOS_func) ptr),   occludedAOP((occludedStreamAOP_func) ptr),   occludedSOA((occludedStreamSOA_func) ptr),   occludedSOP((occludedStreamSOP_func) ptr) {}
 
-    RayStreamFilterFuncs(intersectStreamAOS_func intersectAOS, intersectStreamAOP_func intersectAOP, intersectStreamSOA_func intersectSOA, intersectStreamSOP_func intersectSOP,
+    RayStreamFilterFuncs(intersectStreamAOS_func intersectAOS, intersectStreamAOP_func intersectAOP, intersectStreamSOA_func intersectSOA, intersectStreamSOP_func intersectSOP, intersectStreamTile_func intersectTile,
                          occludedStreamAOS_func  occludedAOS,  occludedStreamAOP_func  occludedAOP,  occludedStreamSOA_func  occludedSOA,  occludedStreamSOP_func  occludedSOP)
-    : intersectAOS(intersectAOS), intersectAOP(intersectAOP), intersectSOA(intersectSOA), intersectSOP(intersectSOP),
+    : intersectAOS(intersectAOS), intersectAOP(intersectAOP), intersectSOA(intersectSOA), intersectSOP(intersectSOP), intersectTile(intersectTile),
       occludedAOS(occludedAOS),   occludedAOP(occludedAOP),   occludedSOA(occludedSOA),   occludedSOP(occludedSOP) {}
 
   public:
@@ -545,6 +557,7 @@ namespace embree
     intersectStreamAOP_func intersectAOP;
     intersectStreamSOA_func intersectSOA;
     intersectStreamSOP_func intersectSOP;
+    intersectStreamTile_func intersectTile;
 
     occludedStreamAOS_func occludedAOS;
     occludedStreamAOP_func occludedAOP;
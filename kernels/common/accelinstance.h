@@ -34,6 +34,10 @@ namespace embree
       if (builder) builder->clear();
     }
 
+    size_t bytesAllocated() {
+      return accel ? accel->bytesAllocated() : 0;
+    }
+
   private:
     std::unique_ptr<AccelData> accel;
     std::unique_ptr<Builder> builder;
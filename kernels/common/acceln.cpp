@@ -31,6 +31,30 @@ namespace embree
     accels.clear();
   }
 
+  /* checks if a ray is not masked out by all geometries of an acceleration structure */
+  static __forceinline bool isVisible(const Accel* accel, unsigned int mask)
+  {
+#if defined(EMBREE_RAY_MASK)
+    return (mask & accel->mask) != 0;
+#else
+    return true;
+#endif
+  }
+
+  /* checks if some active ray of a packet is not masked out by all geometries of an acceleration structure */
+  template<int K>
+  static __forceinline bool isVisible(const Accel* accel, const void* valid, const unsigned int* mask)
+  {
+#if defined(EMBREE_RAY_MASK)
+    if (likely(accel->mask == unsigned(-1))) return true;
+    for (size_t k=0; k<K; k++)
+      if (((const int*)valid)[k] && (mask[k] & accel->mask)) return true;
+    return false;
+#else
+    return true;
+#endif
+  }
+
   bool AccelN::pointQuery (Accel::Intersectors* This_in, PointQuery* query, PointQueryContext* context)
   {
     bool changed = false;
@@ -45,7 +69,7 @@ namespace embree
   {
     AccelN* This = (AccelN*)This_in->ptr;
     for (size_t i=0; i<This->accels.size(); i++)
-      if (!This->accels[i]->isEmpty())
+      if (!This->accels[i]->isEmpty() && isVisible(This->accels[i],ray.ray.mask))
         This->accels[i]->intersectors.intersect(ray,context);
   }
 
@@ -53,7 +77,7 @@ namespace embree
   {
     AccelN* This = (AccelN*)This_in->ptr;
     for (size_t i=0; i<This->accels.size(); i++)
-      if (!This->accels[i]->isEmpty())
+      if (!This->accels[i]->isEmpty() && isVisible<4>(This->accels[i],valid,ray.ray.mask))
         This->accels[i]->intersectors.intersect4(valid,ray,context);
   }
 
@@ -61,7 +85,7 @@ namespace embree
   {
     AccelN* This = (AccelN*)This_in->ptr;
     for (size_t i=0; i<This->accels.size(); i++)
-      if (!This->accels[i]->isEmpty())
+      if (!This->accels[i]->isEmpty() && isVisible<8>(This->accels[i],valid,ray.ray.mask))
         This->accels[i]->intersectors.intersect8(valid,ray,context);
   }
 
@@ -69,7 +93,7 @@ namespace embree
   {
     AccelN* This = (AccelN*)This_in->ptr;
     for (size_t i=0; i<This->accels.size(); i++)
-      if (!This->accels[i]->isEmpty())
+      if (!This->accels[i]->isEmpty() && isVisible<16>(This->accels[i],valid,ray.ray.mask))
         This->accels[i]->intersectors.intersect16(valid,ray,context);
   }
 
@@ -85,7 +109,7 @@ namespace embree
   {
     AccelN* This = (AccelN*)This_in->ptr;
     for (size_t i=0; i<This->accels.size(); i++) {
-      if (This->accels[i]->isEmpty()) continue;
+      if (This->accels[i]->isEmpty() || !isVisible(This->accels[i],ray.mask)) continue;
       This->accels[i]->intersectors.occluded(ray,context); 
       if (ray.tfar < 0.0f) break; 
     }
@@ -95,7 +119,7 @@ namespace embree
   {
     AccelN* This = (AccelN*)This_in->ptr;
     for (size_t i=0; i<This->accels.size(); i++) {
-      if (This->accels[i]->isEmpty()) continue;
+      if (This->accels[i]->isEmpty() || !isVisible<4>(This->accels[i],valid,ray.mask)) continue;
       This->accels[i]->intersectors.occluded4(valid,ray,context);
 #if defined(__SSE2__) || defined(__ARM_NEON)
       vbool4 valid0 = asBool(((vint4*)valid)[0]);
@@ -109,7 +133,7 @@ namespace embree
   {
     AccelN* This = (AccelN*)This_in->ptr;
     for (size_t i=0; i<This->accels.size(); i++) {
-      if (This->accels[i]->isEmpty()) continue;
+      if (This->accels[i]->isEmpty() || !isVisible<8>(This->accels[i],valid,ray.mask)) continue;
       This->accels[i]->intersectors.occluded8(valid,ray,context);
 #if defined(__SSE2__) || defined(__ARM_NEON) // FIXME: use higher ISA
       vbool4 valid0 = asBool(((vint4*)valid)[0]);
@@ -125,7 +149,7 @@ namespace embree
   {
     AccelN* This = (AccelN*)This_in->ptr;
     for (size_t i=0; i<This->accels.size(); i++) {
-      if (This->accels[i]->isEmpty()) continue;
+      if (This->accels[i]->isEmpty() || !isVisible<16>(This->accels[i],valid,ray.mask)) continue;
       This->accels[i]->intersectors.occluded16(valid,ray,context);
 #if defined(__SSE2__) || defined(__ARM_NEON) // FIXME: use higher ISA
       vbool4 valid0 = asBool(((vint4*)valid)[0]);
@@ -188,10 +212,17 @@ namespace embree
       valid16 &= (bool) accels[i]->intersectors.intersector16;
     }
 
-    if (accels.size() == 1) {
-      type = accels[0]->type; // FIXME: should just assign entire Accel
-      bounds = accels[0]->bounds;
-      intersectors = accels[0]->intersectors;
+    /* directly use the specialized intersectors if only a single acceleration structure is not empty */
+    size_t numNonEmpty = 0, nonEmpty = 0;
+    for (size_t i=0; i<accels.size(); i++) {
+      if (accels[i]->isEmpty()) continue;
+      numNonEmpty++; nonEmpty = i;
+    }
+
+    if (accels.size() == 1 || numNonEmpty == 1) {
+      type = accels[nonEmpty]->type; // FIXME: should just assign entire Accel
+      bounds = accels[nonEmpty]->bounds;
+      intersectors = accels[nonEmpty]->intersectors;
     }
     else 
     {
@@ -228,5 +259,13 @@ namespace embree
       accels[i]->clear();
     }
   }
+
+  size_t AccelN::bytesAllocated()
+  {
+    size_t bytes = 0;
+    for (size_t i=0; i<accels.size(); i++)
+      bytes += accels[i]->bytesAllocated();
+    return bytes;
+  }
 }
 
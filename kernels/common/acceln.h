@@ -42,6 +42,7 @@ namespace embree
     void accels_select(bool filter);
     void accels_deleteGeometry(size_t geomID);
     void accels_clear ();
+    size_t bytesAllocated();
 
   public:
     std::vector<Accel*> accels;
@@ -0,0 +1,237 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "autotune.h"
+#include "scene.h"
+#include "context.h"
+#include "../../common/sys/mutex.h"
+
+#include <fstream>
+#include <sstream>
+#include <map>
+
+namespace embree
+{
+  /* configurations found in this process, also used when no cache file is specified */
+  static MutexSys g_autotune_mutex;
+  static std::map<uint64_t,std::string> g_autotune_configs;
+
+  static __forceinline uint64_t hash(uint64_t h, uint64_t v)
+  {
+    /* FNV-1a over the 8 bytes of the value */
+    for (size_t i=0; i<8; i++) {
+      h ^= (v >> (8*i)) & 0xFF;
+      h *= 0x100000001b3ull;
+    }
+    return h;
+  }
+
+  /* small linear congruential generator to make the sampled ray set reproducible */
+  struct AutoTuneRandom
+  {
+    AutoTuneRandom (unsigned int seed) : state(seed) {}
+
+    __forceinline float get()
+    {
+      state = 1664525u*state + 1013904223u;
+      return float(state >> 8) * (1.0f/float(1 << 24));
+    }
+
+    unsigned int state;
+  };
+
+  /* wraps the acceleration structure of the winning candidate, which
+   * already got built during tuning, such that its first build is skipped */
+  class TunedAccel : public Accel
+  {
+  public:
+    TunedAccel (Accel* accel)
+      : Accel(accel->type,accel->intersectors), accel(accel), built(true) {}
+
+    void immutable () {
+      accel->immutable();
+    }
+
+    void build ()
+    {
+      if (!built) accel->build();
+      built = false;
+      bounds = accel->bounds;
+      intersectors = accel->intersectors;
+    }
+
+    void deleteGeometry(size_t geomID) {
+      accel->deleteGeometry(geomID);
+    }
+
+    void clear() {
+      accel->clear();
+      built = false;
+    }
+
+  private:
+    std::unique_ptr<Accel> accel;
+    bool built; //!< true if the acceleration structure is up to date with the scene
+  };
+
+  uint64_t AutoTuner::signature(const std::string& name, const std::vector<Candidate>& candidates) const
+  {
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (size_t i=0; i<name.size(); i++)
+      h = hash(h,name[i]);
+    for (size_t i=0; i<candidates.size(); i++)
+      for (size_t j=0; j<candidates[i].name.size(); j++)
+        h = hash(h,candidates[i].name[j]);
+
+    h = hash(h,scene->getSceneFlags());
+    h = hash(h,scene->getBuildQuality());
+    for (size_t i=0; i<scene->size(); i++)
+    {
+      Geometry* geom = scene->get(i);
+      if (!geom || !geom->isEnabled()) continue;
+      h = hash(h,geom->getType());
+      h = hash(h,geom->size());
+      h = hash(h,geom->numTimeSteps);
+    }
+    return h;
+  }
+
+  uint64_t AutoTuner::trace(Accel* accel) const
+  {
+    const BBox3fa bounds = accel->bounds.bounds();
+    if (accel->isEmpty() || bounds.empty()) return 0;
+
+    const Vec3fa center = 0.5f*(bounds.lower+bounds.upper);
+    const float radius = 0.5f*length(bounds.size());
+
+    RTCIntersectContext user_context;
+    rtcInitIntersectContext(&user_context);
+    IntersectContext context(scene,&user_context);
+
+    AutoTuneRandom rng(0x12345678);
+    const size_t numSamples = scene->device->autotune_samples;
+    uint64_t cycles = 0;
+    for (size_t i=0; i<numSamples; i++)
+    {
+      /* rays start on the bounding sphere and point to a random location inside the scene bounds */
+      const float u = 2.0f*rng.get()-1.0f;
+      const float phi = 2.0f*float(pi)*rng.get();
+      const float r = sqrt(max(0.0f,1.0f-u*u));
+      const Vec3fa org = center + radius*Vec3fa(r*cosf(phi),r*sinf(phi),u);
+      const Vec3fa target = bounds.lower + Vec3fa(rng.get(),rng.get(),rng.get())*bounds.size();
+      const Vec3fa dir = target-org;
+
+      RTCRayHit ray;
+      ray.ray.org_x = org.x; ray.ray.org_y = org.y; ray.ray.org_z = org.z;
+      ray.ray.dir_x = dir.x; ray.ray.dir_y = dir.y; ray.ray.dir_z = dir.z;
+      ray.ray.tnear = 0.0f;
+      ray.ray.tfar = float(inf);
+      ray.ray.time = 0.0f;
+      ray.ray.mask = -1;
+      ray.ray.id = 0;
+      ray.ray.flags = 0;
+      ray.hit.geomID = RTC_INVALID_GEOMETRY_ID;
+      ray.hit.primID = RTC_INVALID_GEOMETRY_ID;
+      ray.hit.instID[0] = RTC_INVALID_GEOMETRY_ID;
+
+      const uint64_t t0 = read_tsc();
+      accel->intersectors.intersect(ray,&context);
+      const uint64_t t1 = read_tsc();
+      cycles += t1-t0;
+    }
+    return cycles;
+  }
+
+  bool AutoTuner::lookup(uint64_t signature, std::string& config) const
+  {
+    Lock<MutexSys> lock(g_autotune_mutex);
+    auto entry = g_autotune_configs.find(signature);
+    if (entry != g_autotune_configs.end()) {
+      config = entry->second;
+      return true;
+    }
+
+    const std::string& filename = scene->device->autotune_cache;
+    if (filename == "") return false;
+
+    /* later entries overwrite earlier ones */
+    bool found = false;
+    std::ifstream file(filename);
+    std::string line;
+    while (std::getline(file,line))
+    {
+      std::istringstream entry(line);
+      uint64_t sig = 0; std::string name;
+      if (!(entry >> std::hex >> sig >> name)) continue;
+      if (sig != signature) continue;
+      config = name;
+      found = true;
+    }
+    if (found) g_autotune_configs[signature] = config;
+    return found;
+  }
+
+  void AutoTuner::store(uint64_t signature, const std::string& config) const
+  {
+    Lock<MutexSys> lock(g_autotune_mutex);
+    g_autotune_configs[signature] = config;
+
+    const std::string& filename = scene->device->autotune_cache;
+    if (filename == "") return;
+
+    std::ofstream file(filename, std::ios::app);
+    if (!file) {
+      if (scene->device->verbosity(1))
+        std::cout << "autotune: cannot write cache file " << filename << std::endl;
+      return;
+    }
+    file << std::hex << signature << " " << config << std::endl;
+  }
+
+  Accel* AutoTuner::select(const std::string& name, const std::vector<Candidate>& candidates)
+  {
+    assert(candidates.size());
+    const uint64_t sig = signature(name,candidates);
+
+    /* use configuration from cache if present */
+    std::string config;
+    if (lookup(sig,config))
+    {
+      for (size_t i=0; i<candidates.size(); i++)
+        if (candidates[i].name == config)
+          return candidates[i].create();
+    }
+
+    /* build and trace each candidate */
+    size_t bestCandidate = 0;
+    double bestCost = inf;
+    std::unique_ptr<Accel> bestAccel;
+    for (size_t i=0; i<candidates.size(); i++)
+    {
+      std::unique_ptr<Accel> accel(candidates[i].create());
+      const uint64_t t0 = read_tsc();
+      accel->build();
+      const uint64_t t1 = read_tsc();
+      const uint64_t traceCycles = trace(accel.get());
+
+      const double buildCost = double(t1-t0);
+      const double traceCost = double(traceCycles)/double(max(size_t(1),scene->device->autotune_samples))*double(scene->device->autotune_rays_per_build);
+      const double cost = buildCost + traceCost;
+      if (scene->device->verbosity(2)) {
+        std::cout << "autotune " << name << ": " << candidates[i].name
+                  << " build = " << 1E-6*buildCost << " Mcycles, trace = " << 1E-6*traceCost << " Mcycles" << std::endl;
+      }
+      if (cost < bestCost) {
+        bestCost = cost;
+        bestCandidate = i;
+        bestAccel = std::move(accel);
+      }
+    }
+
+    if (scene->device->verbosity(1))
+      std::cout << "autotune " << name << ": selected " << candidates[bestCandidate].name << std::endl;
+
+    store(sig,candidates[bestCandidate].name);
+    return new TunedAccel(bestAccel.release());
+  }
+}
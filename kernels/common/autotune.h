@@ -0,0 +1,56 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "default.h"
+#include "accel.h"
+#include <functional>
+
+namespace embree
+{
+  class Scene;
+
+  /*! Selects the acceleration structure of a scene by building each
+   *  candidate configuration and tracing a sampled set of rays. The
+   *  winning configuration is cached by scene signature. */
+  class AutoTuner
+  {
+  public:
+
+    /*! candidate acceleration structure configuration */
+    struct Candidate
+    {
+      Candidate (const std::string& name, const std::function<Accel*()>& create)
+        : name(name), create(create) {}
+
+    public:
+      std::string name;                    //!< name of configuration, stored in cache
+      std::function<Accel*()> create;      //!< creates acceleration structure for this configuration
+    };
+
+  public:
+    AutoTuner (Scene* scene)
+      : scene(scene) {}
+
+    /*! returns the acceleration structure of the best candidate */
+    Accel* select(const std::string& name, const std::vector<Candidate>& candidates);
+
+  private:
+
+    /*! calculates signature of scene and candidate set */
+    uint64_t signature(const std::string& name, const std::vector<Candidate>& candidates) const;
+
+    /*! traces sampled rays through the acceleration structure and returns required cycles */
+    uint64_t trace(Accel* accel) const;
+
+    /*! looks up signature in cache */
+    bool lookup(uint64_t signature, std::string& config) const;
+
+    /*! stores best configuration in cache */
+    void store(uint64_t signature, const std::string& config) const;
+
+  private:
+    Scene* scene;
+  };
+}
@@ -28,6 +28,10 @@ namespace embree
     __forceinline bool isIncoherent() const {
       return embree::isIncoherent(user->flags);
     }
+
+    __forceinline bool isCompact() const {
+      return embree::isCompact(user->flags);
+    }
     
   public:
     Scene* scene;
@@ -105,10 +109,12 @@ namespace embree
         return;
       }
 
+      /* the query sphere becomes an ellipsoid in instance space, its
+       * tight bounds are given by the row norms of the linear part,
+       * which is smaller than the bounds of the transformed box */
       const AffineSpace3fa m = AffineSpace3fa_load_unaligned((AffineSpace3fa*)userContext->world2inst[userContext->instStackSize-1]);
-      BBox3fa bbox(Vec3fa(-query_ws->radius), Vec3fa(query_ws->radius));
-      bbox = xfmBounds(m, bbox);
-      query_radius = 0.5f * (bbox.upper - bbox.lower);
+      const LinearSpace3fa l = m.l.transposed();
+      query_radius = query_ws->radius * Vec3fa(length(l.vx), length(l.vy), length(l.vz));
     }
 
 public:
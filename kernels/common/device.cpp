@@ -3,6 +3,7 @@
 
 #include "device.h"
 #include "../hash.h"
+#include "scene.h"
 #include "scene_triangle_mesh.h"
 #include "scene_user_geometry.h"
 #include "scene_instance.h"
@@ -37,6 +38,7 @@ namespace embree
   static std::map<Device*,size_t> g_num_threads_map;
 
   Device::Device (const char* cfg)
+    : lazyEpoch(0)
   {
     /* check that CPU supports lowest ISA */
     if (!hasISA(ISA)) {
@@ -402,6 +404,16 @@ namespace embree
     case 1000003: debug_int3 = val; return;
     }
 
+    /* packet traversal statistics can get reset */
+    switch (prop)
+    {
+    case RTC_DEVICE_PROPERTY_PACKET_TRAVERSAL_COUNT  : packetStats.packets     = val; return;
+    case RTC_DEVICE_PROPERTY_PACKET_NODE_VISIT_COUNT : packetStats.nodeVisits  = val; return;
+    case RTC_DEVICE_PROPERTY_PACKET_ACTIVE_LANE_COUNT: packetStats.activeLanes = val; return;
+    case RTC_DEVICE_PROPERTY_PACKET_SWITCH_COUNT     : packetStats.switches    = val; return;
+    default: break;
+    }
+
     throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "unknown writable property");
   }
 
@@ -555,7 +567,57 @@ namespace embree
     case RTC_DEVICE_PROPERTY_PARALLEL_COMMIT_SUPPORTED: return 0;
 #endif
 
+    case RTC_DEVICE_PROPERTY_PACKET_TRAVERSAL_COUNT  : return packetStats.packets;
+    case RTC_DEVICE_PROPERTY_PACKET_NODE_VISIT_COUNT : return packetStats.nodeVisits;
+    case RTC_DEVICE_PROPERTY_PACKET_ACTIVE_LANE_COUNT: return packetStats.activeLanes;
+    case RTC_DEVICE_PROPERTY_PACKET_SWITCH_COUNT     : return packetStats.switches;
+
     default: throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "unknown readable property"); break;
     };
   }
+
+  void Device::addLazyScene(Scene* scene, size_t bytes)
+  {
+    Lock<MutexSys> lock(lazyMutex);
+    lazyScenes.push_back(std::make_pair(scene,bytes));
+  }
+
+  void Device::removeLazyScene(Scene* scene)
+  {
+    Lock<MutexSys> lock(lazyMutex);
+    for (size_t i=0; i<lazyScenes.size(); i++) {
+      if (lazyScenes[i].first != scene) continue;
+      lazyScenes.erase(lazyScenes.begin()+i);
+      return;
+    }
+  }
+
+  void Device::evictLazyScenes()
+  {
+    const size_t epoch = lazyEpoch++;
+    if (lazy_build_memory_budget == 0)
+      return;
+
+    Lock<MutexSys> lock(lazyMutex);
+    size_t bytes = 0;
+    for (auto& s : lazyScenes) bytes += s.second;
+    if (bytes <= lazy_build_memory_budget)
+      return;
+
+    /* free least recently visited scenes first, scenes visited during the last frame are kept */
+    std::sort(lazyScenes.begin(),lazyScenes.end(),[] (const std::pair<Scene*,size_t>& a, const std::pair<Scene*,size_t>& b) {
+        return a.first->lazy_epoch < b.first->lazy_epoch;
+      });
+
+    size_t i = 0;
+    for (; i<lazyScenes.size() && bytes > lazy_build_memory_budget; i++)
+    {
+      Scene* scene = lazyScenes[i].first;
+      if (scene->lazy_epoch >= epoch) break;
+      if (!scene->evictLazy()) continue;
+      bytes -= lazyScenes[i].second;
+      lazyScenes[i].first = nullptr;
+    }
+    lazyScenes.erase(std::remove_if(lazyScenes.begin(),lazyScenes.end(),[] (const std::pair<Scene*,size_t>& s) { return s.first == nullptr; }),lazyScenes.end());
+  }
 }
@@ -10,6 +10,7 @@
 namespace embree
 {
   class BVH4Factory;
+  class Scene;
   class BVH8Factory;
 
   class Device : public State, public MemoryMonitorInterface
@@ -54,6 +55,15 @@ namespace embree
     /*! gets a property */
     ssize_t getProperty(const RTCDeviceProperty prop);
 
+    /*! registers a lazily built scene and the bytes its acceleration structures consume */
+    void addLazyScene(Scene* scene, size_t bytes);
+
+    /*! unregisters a lazily built scene */
+    void removeLazyScene(Scene* scene);
+
+    /*! ends the frame of lazily built scenes and frees the least recently visited ones until the memory budget is met */
+    void evictLazyScenes();
+
   private:
 
     /*! initializes the tasking system */
@@ -69,6 +79,44 @@ namespace embree
     static ssize_t debug_int2;
     static ssize_t debug_int3;
 
+  public:
+
+    /*! packet traversal statistics, collected when packet_statistics is enabled */
+    struct PacketStatistics
+    {
+      PacketStatistics () { reset(); }
+
+      void reset()
+      {
+        packets = 0;
+        nodeVisits = 0;
+        activeLanes = 0;
+        switches = 0;
+      }
+
+      __forceinline void add(size_t numPackets, size_t numNodeVisits, size_t numActiveLanes, size_t numSwitches)
+      {
+        packets += numPackets;
+        nodeVisits += numNodeVisits;
+        activeLanes += numActiveLanes;
+        switches += numSwitches;
+      }
+
+    public:
+      std::atomic<size_t> packets;       //!< number of packets traversed in packet mode
+      std::atomic<size_t> nodeVisits;    //!< number of inner node visits in packet mode
+      std::atomic<size_t> activeLanes;   //!< sum of active rays over all inner node visits
+      std::atomic<size_t> switches;      //!< number of switches from packet to single ray traversal
+    };
+    PacketStatistics packetStats;
+
+  public:
+    std::atomic<size_t> lazyEpoch;    //!< incremented once per frame by rtcEvictLazyScenes, lazily built scenes record the epoch of their last visit
+
+  private:
+    MutexSys lazyMutex;
+    std::vector<std::pair<Scene*,size_t>> lazyScenes; //!< lazily built scenes and the bytes of their acceleration structures
+
   public:
     std::unique_ptr<BVH4Factory> bvh4_factory;
 #if defined(EMBREE_TARGET_SIMD8)
@@ -58,6 +58,8 @@ namespace embree
 
   Geometry::~Geometry()
   {
+    /* shared acceleration structures allocate through the device */
+    sharedAccels.clear();
     device->refDec();
   }
 
@@ -98,6 +100,43 @@ namespace embree
   {
     ++modCounter_;
     state = (unsigned)State::COMMITTED;
+
+    /* scenes that still use shared acceleration structures keep them alive until they get committed */
+    Lock<SpinLock> lock(sharedAccelsMutex);
+    sharedAccels.clear();
+  }
+
+  /* drops the acceleration structures only the geometry itself still references */
+  template<typename SharedAccels>
+  static void pruneUnreferenced(SharedAccels& accels)
+  {
+    accels.erase(std::remove_if(accels.begin(),accels.end(),[] (const typename SharedAccels::value_type& s) {
+          return s.second->refCount() == 1;
+        }),accels.end());
+  }
+
+  Ref<AccelData> Geometry::getSharedAccel(const AccelKey& key)
+  {
+    Lock<SpinLock> lock(sharedAccelsMutex);
+    pruneUnreferenced(sharedAccels);
+    for (auto& s : sharedAccels)
+      if (s.first == key) return s.second;
+    return nullptr;
+  }
+
+  Ref<AccelData> Geometry::setSharedAccel(const AccelKey& key, const Ref<AccelData>& accel)
+  {
+    Lock<SpinLock> lock(sharedAccelsMutex);
+    for (auto& s : sharedAccels)
+      if (s.first == key) return s.second;
+    sharedAccels.push_back(std::make_pair(key,accel));
+    return accel;
+  }
+
+  void Geometry::pruneSharedAccels()
+  {
+    Lock<SpinLock> lock(sharedAccelsMutex);
+    pruneUnreferenced(sharedAccels);
   }
 
   void Geometry::preCommit()
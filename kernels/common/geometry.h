@@ -422,6 +422,33 @@ namespace embree
       return modCounter_;
     }
 
+    /*! settings of an acceleration structure built over this geometry alone */
+    struct AccelKey
+    {
+      __forceinline AccelKey (const void* type, unsigned int N, unsigned int geomID, unsigned int gtype, unsigned int builder, bool staticAlloc)
+        : type(type), N(N), geomID(geomID), gtype(gtype), builder(builder), staticAlloc(staticAlloc) {}
+
+      __forceinline friend bool operator== (const AccelKey& a, const AccelKey& b) {
+        return a.type == b.type && a.N == b.N && a.geomID == b.geomID && a.gtype == b.gtype && a.builder == b.builder && a.staticAlloc == b.staticAlloc;
+      }
+
+      const void* type;      //!< primitive type stored in the leaves
+      unsigned int N;        //!< branching factor
+      unsigned int geomID;   //!< geometry ID stored in the leaves
+      unsigned int gtype;    //!< geometry types the builder handles
+      unsigned int builder;  //!< builder selection, e.g. build quality
+      bool staticAlloc;      //!< allocation mode of static scenes, dynamic scenes allocate differently
+    };
+
+    /*! returns the acceleration structure shared across scenes with matching settings, or null */
+    Ref<AccelData> getSharedAccel(const AccelKey& key);
+
+    /*! shares an acceleration structure with all scenes the geometry is attached to, returns an acceleration structure with the same settings that got shared concurrently */
+    Ref<AccelData> setSharedAccel(const AccelKey& key, const Ref<AccelData>& accel);
+
+    /*! drops the shared acceleration structures that no scene references anymore */
+    void pruneSharedAccels();
+
     /*! for triangle meshes and bezier curves only */
   public:
 
@@ -566,6 +593,9 @@ namespace embree
     
     unsigned int mask;             //!< for masking out geometry
     unsigned int modCounter_ = 1; //!< counter for every modification - used to rebuild scenes when geo is modified
+
+    SpinLock sharedAccelsMutex;
+    std::vector<std::pair<AccelKey,Ref<AccelData>>> sharedAccels; //!< acceleration structures over this geometry shared by scenes, dropped on commit
     
     struct {
       GType gtype : 8;                //!< geometry type
@@ -22,7 +22,7 @@ namespace embree
     {
       for (unsigned l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; ++l)
         instID[l] = RTC_INVALID_GEOMETRY_ID;
-      instance_id_stack::copy_UV<K>(context->instID, instID);
+      instance_id_stack::copy_UV<K>(context, instID);
     }
 
     /* Returns the size of the hit */
@@ -48,7 +48,7 @@ namespace embree
     __forceinline HitK(const RTCIntersectContext* context, unsigned int geomID, unsigned int primID, float u, float v, const Vec3fa& Ng)
       : Ng(Ng.x,Ng.y,Ng.z), u(u), v(v), primID(primID), geomID(geomID)
     {
-      instance_id_stack::copy_UU(context->instID, instID);
+      instance_id_stack::copy_UU(context, instID);
     }
 
     /* Returns the size of the hit */
@@ -175,5 +175,71 @@ RTC_FORCEINLINE void copy_VV(const vuint<K>* src, vuint<K>* tgt, const vbool<K>&
 #endif
 }
 
+/*
+ * Copies the instance ID stack of the context.
+ * Only the levels currently pushed to the stack get copied, followed by
+ * an invalid ID if the stack is not full. Thus hits in shallow instance
+ * hierarchies do not touch the remaining levels, independent of
+ * RTC_MAX_INSTANCE_LEVEL_COUNT.
+ */
+RTC_FORCEINLINE void copy_UU(const RTCIntersectContext* context, unsigned* tgt)
+{
+#if (RTC_MAX_INSTANCE_LEVEL_COUNT == 1)
+  tgt[0] = context->instID[0];
+
+#else
+  const unsigned depth = context->instStackSize;
+  for (unsigned l = 0; l < depth; ++l)
+    tgt[l] = context->instID[l];
+  if (depth < RTC_MAX_INSTANCE_LEVEL_COUNT)
+    tgt[depth] = RTC_INVALID_GEOMETRY_ID;
+#endif
+}
+
+template <int K>
+RTC_FORCEINLINE void copy_UV(const RTCIntersectContext* context, vuint<K>* tgt)
+{
+#if (RTC_MAX_INSTANCE_LEVEL_COUNT == 1)
+  tgt[0] = context->instID[0];
+
+#else
+  const unsigned depth = context->instStackSize;
+  for (unsigned l = 0; l < depth; ++l)
+    tgt[l] = context->instID[l];
+  if (depth < RTC_MAX_INSTANCE_LEVEL_COUNT)
+    tgt[depth] = RTC_INVALID_GEOMETRY_ID;
+#endif
+}
+
+template <int K>
+RTC_FORCEINLINE void copy_UV(const RTCIntersectContext* context, vuint<K>* tgt, size_t j)
+{
+#if (RTC_MAX_INSTANCE_LEVEL_COUNT == 1)
+  tgt[0][j] = context->instID[0];
+
+#else
+  const unsigned depth = context->instStackSize;
+  for (unsigned l = 0; l < depth; ++l)
+    tgt[l][j] = context->instID[l];
+  if (depth < RTC_MAX_INSTANCE_LEVEL_COUNT)
+    tgt[depth][j] = RTC_INVALID_GEOMETRY_ID;
+#endif
+}
+
+template <int K>
+RTC_FORCEINLINE void copy_UV(const RTCIntersectContext* context, vuint<K>* tgt, const vbool<K>& mask)
+{
+#if (RTC_MAX_INSTANCE_LEVEL_COUNT == 1)
+  vuint<K>::store(mask, tgt, context->instID[0]);
+
+#else
+  const unsigned depth = context->instStackSize;
+  for (unsigned l = 0; l < depth; ++l)
+    vuint<K>::store(mask, tgt + l, context->instID[l]);
+  if (depth < RTC_MAX_INSTANCE_LEVEL_COUNT)
+    vuint<K>::store(mask, tgt + depth, RTC_INVALID_GEOMETRY_ID);
+#endif
+}
+
 } // namespace instance_id_stack
 } // namespace embree
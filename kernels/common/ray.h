@@ -11,6 +11,7 @@
 namespace embree
 {
   static const size_t MAX_INTERNAL_STREAM_SIZE = 32;
+  static const size_t MAX_INTERNAL_TILE_SIZE = 256;
 
   /* Ray structure for K rays */
   template<int K>
@@ -0,0 +1,195 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "rayqueue.h"
+#include "context.h"
+#include "../../common/algorithms/parallel_for.h"
+
+namespace embree
+{
+  static __forceinline void storeRay(RTCRayHit16& packet, size_t i, const RTCRayHit& rayhit)
+  {
+    packet.ray.org_x[i] = rayhit.ray.org_x;
+    packet.ray.org_y[i] = rayhit.ray.org_y;
+    packet.ray.org_z[i] = rayhit.ray.org_z;
+    packet.ray.tnear[i] = rayhit.ray.tnear;
+    packet.ray.dir_x[i] = rayhit.ray.dir_x;
+    packet.ray.dir_y[i] = rayhit.ray.dir_y;
+    packet.ray.dir_z[i] = rayhit.ray.dir_z;
+    packet.ray.time[i]  = rayhit.ray.time;
+    packet.ray.tfar[i]  = rayhit.ray.tfar;
+    packet.ray.mask[i]  = rayhit.ray.mask;
+    packet.ray.id[i]    = rayhit.ray.id;
+    packet.ray.flags[i] = rayhit.ray.flags;
+    packet.hit.geomID[i] = RTC_INVALID_GEOMETRY_ID;
+    for (size_t l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+      packet.hit.instID[l][i] = RTC_INVALID_GEOMETRY_ID;
+  }
+
+  static __forceinline void loadRay(const RTCRayHit16& packet, size_t i, RTCRayHit& rayhit)
+  {
+    rayhit.ray.org_x = packet.ray.org_x[i];
+    rayhit.ray.org_y = packet.ray.org_y[i];
+    rayhit.ray.org_z = packet.ray.org_z[i];
+    rayhit.ray.tnear = packet.ray.tnear[i];
+    rayhit.ray.dir_x = packet.ray.dir_x[i];
+    rayhit.ray.dir_y = packet.ray.dir_y[i];
+    rayhit.ray.dir_z = packet.ray.dir_z[i];
+    rayhit.ray.time  = packet.ray.time[i];
+    rayhit.ray.tfar  = packet.ray.tfar[i];
+    rayhit.ray.mask  = packet.ray.mask[i];
+    rayhit.ray.id    = packet.ray.id[i];
+    rayhit.ray.flags = packet.ray.flags[i];
+    rayhit.hit.Ng_x  = packet.hit.Ng_x[i];
+    rayhit.hit.Ng_y  = packet.hit.Ng_y[i];
+    rayhit.hit.Ng_z  = packet.hit.Ng_z[i];
+    rayhit.hit.u     = packet.hit.u[i];
+    rayhit.hit.v     = packet.hit.v[i];
+    rayhit.hit.primID = packet.hit.primID[i];
+    rayhit.hit.geomID = packet.hit.geomID[i];
+    for (size_t l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+      rayhit.hit.instID[l] = packet.hit.instID[l][i];
+  }
+
+  RayQueue::RayQueue (Scene* scene, RTCIntersectContextFlags flags, RTCRayQueueFunction callback, void* userPtr)
+    : scene(scene), flags(flags), callback(callback), userPtr(userPtr), current(nullptr)
+  {
+    current.store(allocChunk());
+  }
+
+  RayQueue::~RayQueue ()
+  {
+    delete current.load();
+    for (size_t i=0; i<pending.size(); i++) delete pending[i];
+    for (size_t i=0; i<freeChunks.size(); i++) delete freeChunks[i];
+  }
+
+  RayQueue::Chunk* RayQueue::allocChunk()
+  {
+    {
+      Lock<SpinLock> lock(mutex);
+      if (freeChunks.size())
+      {
+        Chunk* chunk = freeChunks.back();
+        freeChunks.pop_back();
+        chunk->reserved.store(0);
+        chunk->written.store(0);
+        return chunk;
+      }
+    }
+    return new Chunk;
+  }
+
+  void RayQueue::enqueue(const RTCRayHit* rayhits, size_t M, size_t byteStride)
+  {
+    size_t i = 0;
+    while (i < M)
+    {
+      /* reserve slots in current chunk without locking */
+      Chunk* chunk = current.load();
+      size_t begin = chunk->reserved.load();
+      if (unlikely(begin >= CHUNK_SIZE)) {
+        pause_cpu(); // another thread is replacing the filled chunk
+        continue;
+      }
+      const size_t num = min(M-i,CHUNK_SIZE-begin);
+      if (!chunk->reserved.compare_exchange_weak(begin,begin+num))
+        continue;
+
+      for (size_t j=0; j<num; j++) {
+        const size_t slot = begin+j;
+        const RTCRayHit& rayhit = *(const RTCRayHit*)((const char*)rayhits + (i+j)*byteStride);
+        storeRay(chunk->packets[slot/PACKET_SIZE],slot%PACKET_SIZE,rayhit);
+      }
+      chunk->written.fetch_add(num);
+      i += num;
+
+      /* the thread that filled the chunk replaces it */
+      if (begin+num == CHUNK_SIZE)
+      {
+        current.store(allocChunk());
+
+        std::vector<Chunk*> chunks;
+        {
+          Lock<SpinLock> lock(mutex);
+          pending.push_back(chunk);
+          if (pending.size() >= MAX_PENDING_CHUNKS)
+            chunks.swap(pending);
+        }
+        if (chunks.size()) trace(chunks);
+      }
+    }
+  }
+
+  void RayQueue::flush()
+  {
+    std::vector<Chunk*> chunks;
+    {
+      Lock<SpinLock> lock(mutex);
+      chunks.swap(pending);
+    }
+
+    Chunk* chunk = current.load();
+    if (chunk->reserved.load()) {
+      current.store(allocChunk());
+      chunks.push_back(chunk);
+    }
+
+    trace(chunks);
+  }
+
+  void RayQueue::trace(std::vector<Chunk*>& chunks)
+  {
+    try {
+      if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+
+      parallel_for(size_t(0), chunks.size(), [&] (const range<size_t>& r) {
+          for (size_t i=r.begin(); i<r.end(); i++)
+            trace(chunks[i]);
+        });
+    }
+    catch (...) {
+      Lock<SpinLock> lock(mutex);
+      pending.insert(pending.end(),chunks.begin(),chunks.end());
+      throw;
+    }
+
+    Lock<SpinLock> lock(mutex);
+    freeChunks.insert(freeChunks.end(),chunks.begin(),chunks.end());
+  }
+
+  void RayQueue::trace(Chunk* chunk)
+  {
+    /* wait for other threads to finish writing their rays */
+    const size_t numRays = min(chunk->reserved.load(),CHUNK_SIZE);
+    while (chunk->written.load() < numRays)
+      pause_cpu();
+
+    /* disable unused rays of last packet */
+    const size_t numPackets = (numRays+PACKET_SIZE-1)/PACKET_SIZE;
+    for (size_t i=numRays; i<numPackets*PACKET_SIZE; i++) {
+      chunk->packets[i/PACKET_SIZE].ray.tnear[i%PACKET_SIZE] = 0.0f;
+      chunk->packets[i/PACKET_SIZE].ray.tfar [i%PACKET_SIZE] = float(neg_inf);
+    }
+
+    RTCIntersectContext user_context;
+    rtcInitIntersectContext(&user_context);
+    user_context.flags = flags;
+    scene->visitLazy();
+    IntersectContext context(scene.ptr,&user_context);
+
+    RTCRayHit* rayhits = chunk->rayhits;
+#if defined(EMBREE_RAY_PACKETS)
+    scene->device->rayStreamFilters.intersectSOA(scene.ptr,(char*)chunk->packets,PACKET_SIZE,numPackets,sizeof(RTCRayHit16),&context);
+    for (size_t i=0; i<numRays; i++)
+      loadRay(chunk->packets[i/PACKET_SIZE],i%PACKET_SIZE,rayhits[i]);
+#else
+    for (size_t i=0; i<numRays; i++) {
+      loadRay(chunk->packets[i/PACKET_SIZE],i%PACKET_SIZE,rayhits[i]);
+      if (likely(rayhits[i].ray.tnear <= rayhits[i].ray.tfar))
+        scene->intersectors.intersect(rayhits[i],&context);
+    }
+#endif
+    callback(userPtr,rayhits,(unsigned int)numRays);
+  }
+}
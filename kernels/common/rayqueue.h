@@ -0,0 +1,70 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "default.h"
+#include "scene.h"
+
+namespace embree
+{
+  /*! Accumulates rays enqueued by many threads into SOA packets of
+   *  full SIMD width, traces filled chunks of packets using the task
+   *  scheduler, and delivers the hits in batches to a callback. */
+  class RayQueue : public RefCount
+  {
+    ALIGNED_CLASS_(64);
+  public:
+
+    static const size_t PACKET_SIZE = 16;                         //!< number of rays per SOA packet
+    static const size_t CHUNK_PACKETS = 16;                       //!< number of packets per chunk
+    static const size_t CHUNK_SIZE = PACKET_SIZE*CHUNK_PACKETS;   //!< number of rays per chunk
+    static const size_t MAX_PENDING_CHUNKS = 64;                  //!< filled chunks get traced when that many are pending
+
+    /*! chunk of rays in SOA layout */
+    struct Chunk
+    {
+      ALIGNED_STRUCT_(64);
+
+      Chunk () : reserved(0), written(0) {}
+
+      RTCRayHit16 packets[CHUNK_PACKETS];   //!< SOA storage of rays
+      RTCRayHit rayhits[CHUNK_SIZE];        //!< AOS storage of traced rays passed to the callback
+      std::atomic<size_t> reserved;         //!< number of ray slots reserved by enqueuing threads
+      std::atomic<size_t> written;          //!< number of rays fully written
+    };
+
+  public:
+    RayQueue (Scene* scene, RTCIntersectContextFlags flags, RTCRayQueueFunction callback, void* userPtr);
+    ~RayQueue ();
+
+    /*! enqueues a stream of rays, thread safe */
+    void enqueue(const RTCRayHit* rayhits, size_t M, size_t byteStride);
+
+    /*! traces all enqueued rays, must not get called concurrently with enqueue */
+    void flush();
+
+  private:
+
+    /*! returns an empty chunk */
+    Chunk* allocChunk();
+
+    /*! traces a set of chunks in parallel and recycles them, chunks get pending again if an exception is thrown */
+    void trace(std::vector<Chunk*>& chunks);
+
+    /*! traces a single chunk and delivers its hits */
+    void trace(Chunk* chunk);
+
+  public:
+    Ref<Scene> scene;                    //!< scene to trace rays through
+    RTCIntersectContextFlags flags;      //!< intersection context flags used for traversal
+    RTCRayQueueFunction callback;        //!< receives batches of intersected rays
+    void* userPtr;                       //!< user pointer passed to callback
+
+  private:
+    std::atomic<Chunk*> current;         //!< chunk rays get currently enqueued into
+    SpinLock mutex;                      //!< protects lists of pending and free chunks
+    std::vector<Chunk*> pending;         //!< filled chunks that are not traced yet
+    std::vector<Chunk*> freeChunks;      //!< chunks available for reuse
+  };
+}
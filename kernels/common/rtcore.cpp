@@ -7,6 +7,7 @@
 #include "device.h"
 #include "scene.h"
 #include "context.h"
+#include "rayqueue.h"
 #include "../geometry/filter.h"
 #include "../../include/embree3/rtcore_ray.h"
 using namespace embree;
@@ -203,6 +204,18 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(scene);
   }
 
+  RTC_API void rtcSetSceneFootprintDistanceFactor (RTCScene hscene, float factor) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetSceneFootprintDistanceFactor);
+    RTC_VERIFY_HANDLE(hscene);
+    if (!(factor >= 0.0f && factor < float(inf)))
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid footprint distance factor");
+    scene->setFootprintDistanceFactor(factor);
+    RTC_CATCH_END2(scene);
+  }
+
   RTC_API void rtcSetSceneFlags (RTCScene hscene, RTCSceneFlags flags) 
   {
     Scene* scene = (Scene*) hscene;
@@ -244,6 +257,32 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(scene);
   }
 
+  RTC_API void rtcCommitScenes (RTCScene* hscenes, size_t numScenes) 
+  {
+    Scene* scene0 = (hscenes && numScenes) ? (Scene*) hscenes[0] : nullptr;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcCommitScenes);
+    if (numScenes == 0) return;
+    RTC_VERIFY_HANDLE(hscenes);
+    for (size_t i=0; i<numScenes; i++) {
+      RTC_VERIFY_HANDLE(hscenes[i]);
+      if (((Scene*)hscenes[i])->device != scene0->device)
+        throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"scenes of a batch commit have to belong to the same device");
+    }
+    Scene::commitScenes((Scene**)hscenes,numScenes);
+    RTC_CATCH_END2(scene0);
+  }
+
+  RTC_API void rtcEvictLazyScenes (RTCDevice hdevice)
+  {
+    Device* device = (Device*) hdevice;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcEvictLazyScenes);
+    RTC_VERIFY_HANDLE(hdevice);
+    device->evictLazyScenes();
+    RTC_CATCH_END(device);
+  }
+
   RTC_API void rtcGetSceneBounds(RTCScene hscene, RTCBounds* bounds_o)
   {
     Scene* scene = (Scene*) hscene;
@@ -293,6 +332,18 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(scene);
   }
 
+  RTC_API void rtcGetSceneStatistics(RTCScene hscene, RTCSceneStatistics* stats_o)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcGetSceneStatistics);
+    RTC_VERIFY_HANDLE(hscene);
+    if (stats_o == nullptr)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"invalid destination pointer");
+    scene->statistics.get(*stats_o);
+    RTC_CATCH_END2(scene);
+  }
+
   RTC_API void rtcCollide (RTCScene hscene0, RTCScene hscene1, RTCCollideFunc callback, void* userPtr)
   {
     Scene* scene0 = (Scene*) hscene0;
@@ -309,12 +360,96 @@ RTC_NAMESPACE_BEGIN;
     auto nUserPrims1 = scene1->getNumPrimitives (Geometry::MTY_USER_GEOMETRY, false);
     if (scene0->numPrimitives() != nUserPrims0 && scene1->numPrimitives() != nUserPrims1) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scenes must only contain user geometries with a single timestep");
 #endif
-    scene0->intersectors.collide(scene0,scene1,callback,userPtr);
+    scene0->visitLazy();
+    scene1->visitLazy();
+    scene0->intersectors.collide(scene0,scene1,callback,nullptr,userPtr);
+    RTC_CATCH_END(scene0->device);
+  }
+
+  RTC_API void rtcCollideInstanced (RTCScene hscene0, RTCScene hscene1, RTCCollideInstancedFunc callback, void* userPtr)
+  {
+    Scene* scene0 = (Scene*) hscene0;
+    Scene* scene1 = (Scene*) hscene1;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcCollideInstanced);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene0);
+    RTC_VERIFY_HANDLE(hscene1);
+    if (scene0->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (scene1->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (scene0->device != scene1->device) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scenes are from different devices");
+#endif
+    if (callback == nullptr) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid callback");
+    scene0->visitLazy();
+    scene1->visitLazy();
+    scene0->intersectors.collide(scene0,scene1,nullptr,callback,userPtr);
     RTC_CATCH_END(scene0->device);
   }
   
+  RTC_API RTCRayQueue rtcNewRayQueue (RTCScene hscene, RTCIntersectContextFlags flags, RTCRayQueueFunction callback, void* userPtr)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcNewRayQueue);
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_VERIFY_HANDLE(callback);
+    RayQueue* queue = new RayQueue(scene,flags,callback,userPtr);
+    return (RTCRayQueue) queue->refInc();
+    RTC_CATCH_END2(scene);
+    return nullptr;
+  }
+
+  RTC_API void rtcRetainRayQueue (RTCRayQueue hqueue)
+  {
+    RayQueue* queue = (RayQueue*) hqueue;
+    Scene* scene = queue ? queue->scene.ptr : nullptr;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcRetainRayQueue);
+    RTC_VERIFY_HANDLE(hqueue);
+    queue->refInc();
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcReleaseRayQueue (RTCRayQueue hqueue)
+  {
+    RayQueue* queue = (RayQueue*) hqueue;
+    Scene* scene = queue ? queue->scene.ptr : nullptr;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcReleaseRayQueue);
+    RTC_VERIFY_HANDLE(hqueue);
+    queue->refDec();
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcEnqueueRays (RTCRayQueue hqueue, const RTCRayHit* rayhit, unsigned int M, size_t byteStride)
+  {
+    RayQueue* queue = (RayQueue*) hqueue;
+    Scene* scene = queue ? queue->scene.ptr : nullptr;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcEnqueueRays);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hqueue);
+    if (((size_t)rayhit) & 0x03) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 4 bytes");
+#endif
+    STAT3(normal.travs,M,M,M);
+    queue->enqueue(rayhit,M,byteStride);
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcFlushRayQueue (RTCRayQueue hqueue)
+  {
+    RayQueue* queue = (RayQueue*) hqueue;
+    Scene* scene = queue ? queue->scene.ptr : nullptr;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcFlushRayQueue);
+    RTC_VERIFY_HANDLE(hqueue);
+    queue->flush();
+    RTC_CATCH_END2(scene);
+  }
+
   inline bool pointQuery(Scene* scene, RTCPointQuery* query, RTCPointQueryContext* userContext, RTCPointQueryFunction queryFunc, void* userPtr)
   {
+    scene->visitLazy();
     bool changed = false;
     if (userContext->instStackSize > 0)
     {
@@ -455,6 +590,7 @@ RTC_NAMESPACE_BEGIN;
     if (((size_t)rayhit) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 16 bytes");   
 #endif
     STAT3(normal.travs,1,1,1);
+    scene->visitLazy();
     IntersectContext context(scene,user_context);
     scene->intersectors.intersect(*rayhit,&context);
 #if defined(DEBUG)
@@ -478,6 +614,7 @@ RTC_NAMESPACE_BEGIN;
     STAT(size_t cnt=0; for (size_t i=0; i<4; i++) cnt += ((int*)valid)[i] == -1;);
     STAT3(normal.travs,cnt,cnt,cnt);
 
+    scene->visitLazy();
     IntersectContext context(scene,user_context);
 #if !defined(EMBREE_RAY_PACKETS)
     RayHit4* ray4 = (RayHit4*) rayhit;
@@ -509,6 +646,7 @@ RTC_NAMESPACE_BEGIN;
     STAT(size_t cnt=0; for (size_t i=0; i<8; i++) cnt += ((int*)valid)[i] == -1;);
     STAT3(normal.travs,cnt,cnt,cnt);
 
+    scene->visitLazy();
     IntersectContext context(scene,user_context);
 #if !defined(EMBREE_RAY_PACKETS)
     RayHit8* ray8 = (RayHit8*) rayhit;
@@ -542,6 +680,7 @@ RTC_NAMESPACE_BEGIN;
     STAT(size_t cnt=0; for (size_t i=0; i<16; i++) cnt += ((int*)valid)[i] == -1;);
     STAT3(normal.travs,cnt,cnt,cnt);
 
+    scene->visitLazy();
     IntersectContext context(scene,user_context);
 #if !defined(EMBREE_RAY_PACKETS)
     RayHit16* ray16 = (RayHit16*) rayhit;
@@ -573,6 +712,7 @@ RTC_NAMESPACE_BEGIN;
     if (((size_t)rayhit ) & 0x03) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 4 bytes");   
 #endif
     STAT3(normal.travs,M,M,M);
+    scene->visitLazy();
     IntersectContext context(scene,user_context);
 
     /* fast codepath for single rays */
@@ -604,6 +744,7 @@ RTC_NAMESPACE_BEGIN;
     if (((size_t)rn) & 0x03) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 4 bytes");   
 #endif
     STAT3(normal.travs,M,M,M);
+    scene->visitLazy();
     IntersectContext context(scene,user_context);
 
     /* fast codepath for single rays */
@@ -635,6 +776,7 @@ RTC_NAMESPACE_BEGIN;
     if (((size_t)rayhit) & 0x03) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 4 bytes");   
 #endif
     STAT3(normal.travs,N*M,N*M,N*M);
+    scene->visitLazy();
     IntersectContext context(scene,user_context);
 
     /* code path for single ray streams */
@@ -690,6 +832,7 @@ RTC_NAMESPACE_BEGIN;
     if (((size_t)rayhit->hit.instID) & 0x03 ) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit->hit.instID not aligned to 4 bytes");   
 #endif
     STAT3(normal.travs,N,N,N);
+    scene->visitLazy();
     IntersectContext context(scene,user_context);
     scene->device->rayStreamFilters.intersectSOP(scene,rayhit,N,&context);
 #else
@@ -697,6 +840,39 @@ RTC_NAMESPACE_BEGIN;
 #endif
     RTC_CATCH_END2(scene);
   }
+
+  RTC_API void rtcIntersectTile (RTCScene hscene, RTCIntersectContext* user_context, RTCRayHit16* rayhit, unsigned int M)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcIntersectTile);
+
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (((size_t)rayhit) & 0x3F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit not aligned to 64 bytes");
+#endif
+    if (16*size_t(M) > MAX_INTERNAL_TILE_SIZE) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "too many ray packets in tile");
+    STAT3(normal.travs,16*M,16*M,16*M);
+
+    scene->visitLazy();
+    IntersectContext context(scene,user_context);
+#if !defined(EMBREE_RAY_PACKETS)
+    for (size_t i=0; i<M; i++)
+    {
+      RayHit16* ray16 = (RayHit16*) &rayhit[i];
+      for (size_t j=0; j<16; j++) {
+        RayHit ray1; ray16->get(j,ray1);
+        if (ray1.tnear() > ray1.tfar) continue;
+        scene->intersectors.intersect((RTCRayHit&)ray1,&context);
+        ray16->set(j,ray1);
+      }
+    }
+#else
+    scene->device->rayStreamFilters.intersectTile(scene,rayhit,M,&context);
+#endif
+    RTC_CATCH_END2(scene);
+  }
   
   RTC_API void rtcOccluded1 (RTCScene hscene, RTCIntersectContext* user_context, RTCRay* ray) 
   {
@@ -709,6 +885,7 @@ RTC_NAMESPACE_BEGIN;
     if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
     if (((size_t)ray) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 16 bytes");   
 #endif
+    scene->visitLazy();
     IntersectContext context(scene,user_context);
     scene->intersectors.occluded(*ray,&context);
     RTC_CATCH_END2(scene);
@@ -729,6 +906,7 @@ RTC_NAMESPACE_BEGIN;
     STAT(size_t cnt=0; for (size_t i=0; i<4; i++) cnt += ((int*)valid)[i] == -1;);
     STAT3(shadow.travs,cnt,cnt,cnt);
 
+    scene->visitLazy();
     IntersectContext context(scene,user_context);
 #if !defined(EMBREE_RAY_PACKETS)
     RayHit4* ray4 = (RayHit4*) ray;
@@ -760,6 +938,7 @@ RTC_NAMESPACE_BEGIN;
     STAT(size_t cnt=0; for (size_t i=0; i<8; i++) cnt += ((int*)valid)[i] == -1;);
     STAT3(shadow.travs,cnt,cnt,cnt);
 
+    scene->visitLazy();
     IntersectContext context(scene,user_context);
 #if !defined(EMBREE_RAY_PACKETS)
     RayHit8* ray8 = (RayHit8*) ray;
@@ -794,6 +973,7 @@ RTC_NAMESPACE_BEGIN;
     STAT(size_t cnt=0; for (size_t i=0; i<16; i++) cnt += ((int*)valid)[i] == -1;);
     STAT3(shadow.travs,cnt,cnt,cnt);
 
+    scene->visitLazy();
     IntersectContext context(scene,user_context);
 #if !defined(EMBREE_RAY_PACKETS)
     RayHit16* ray16 = (RayHit16*) ray;
@@ -826,6 +1006,7 @@ RTC_NAMESPACE_BEGIN;
     if (((size_t)ray) & 0x03) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 4 bytes");   
 #endif
     STAT3(shadow.travs,M,M,M);
+    scene->visitLazy();
     IntersectContext context(scene,user_context);
     /* fast codepath for streams of size 1 */
     if (likely(M == 1)) {
@@ -855,6 +1036,7 @@ RTC_NAMESPACE_BEGIN;
     if (((size_t)ray) & 0x03) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 4 bytes");   
 #endif
     STAT3(shadow.travs,M,M,M);
+    scene->visitLazy();
     IntersectContext context(scene,user_context);
 
     /* fast codepath for streams of size 1 */
@@ -886,6 +1068,7 @@ RTC_NAMESPACE_BEGIN;
     if (((size_t)ray) & 0x03) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 4 bytes");   
 #endif
     STAT3(shadow.travs,N*M,N*N,N*N);
+    scene->visitLazy();
     IntersectContext context(scene,user_context);
 
     /* codepath for single rays */
@@ -933,6 +1116,7 @@ RTC_NAMESPACE_BEGIN;
     if (((size_t)ray->mask  ) & 0x03 ) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 4 bytes");   
 #endif
     STAT3(shadow.travs,N,N,N);
+    scene->visitLazy();
     IntersectContext context(scene,user_context);
     scene->device->rayStreamFilters.occludedSOP(scene,ray,N,&context);
 #else
@@ -5,6 +5,7 @@
 
 #include "../bvh/bvh4_factory.h"
 #include "../bvh/bvh8_factory.h"
+#include "autotune.h"
 #include "../../common/algorithms/parallel_reduce.h"
  
 namespace embree
@@ -21,8 +22,8 @@ namespace embree
     : device(device),
       flags_modified(true), enabled_geometry_types(0),
       scene_flags(RTC_SCENE_FLAG_NONE),
-      quality_flags(RTC_BUILD_QUALITY_MEDIUM),
-      is_build(false), modified(true),
+      quality_flags(RTC_BUILD_QUALITY_MEDIUM), footprintDistanceFactor(0.0f),
+      is_build(false), instance_levels(0), lazy_pending(false), lazy_epoch(0), modified(true),
       progressInterface(this), progress_monitor_function(nullptr), progress_monitor_ptr(nullptr), progress_monitor_counter(0)
   {
     device->refInc();
@@ -38,6 +39,12 @@ namespace embree
 
   Scene::~Scene() noexcept
   {
+    /* release the acceleration structures first, such that the geometries drop the BVHs only this scene used */
+    accels_init();
+    for (auto& geometry : geometries)
+      if (geometry) geometry->pruneSharedAccels();
+
+    device->removeLazyScene(this);
     device->refDec();
   }
   
@@ -97,6 +104,10 @@ namespace embree
         int mode =  2*(int)isCompactAccel() + 1*(int)isRobustAccel(); 
         switch (mode) {
         case /*0b00*/ 0: 
+          if (device->autotune && device->tri_builder == "default" && isStaticAccel() && !world.numFilterFunctions) {
+            accels_add(autotuneTriangleAccel());
+            break;
+          }
 #if defined (EMBREE_TARGET_SIMD8)
           if (device->canUseAVX())
 	  {
@@ -158,6 +169,7 @@ namespace embree
     else if (device->tri_accel == "bvh4.triangle4v")      accels_add(device->bvh4_factory->BVH4Triangle4v(this));
     else if (device->tri_accel == "bvh4.triangle4i")      accels_add(device->bvh4_factory->BVH4Triangle4i(this));
     else if (device->tri_accel == "qbvh4.triangle4i")     accels_add(device->bvh4_factory->BVH4QuantizedTriangle4i(this));
+    else if (device->tri_accel == "bvh4obb.triangle4")    accels_add(device->bvh4_factory->BVH4OBBTriangle4(this));
 
 #if defined (EMBREE_TARGET_SIMD8)
     else if (device->tri_accel == "bvh8.triangle4")       accels_add(device->bvh8_factory->BVH8Triangle4 (this));
@@ -170,6 +182,27 @@ namespace embree
 #endif
   }
 
+  Accel* Scene::autotuneTriangleAccel()
+  {
+    std::vector<AutoTuner::Candidate> candidates;
+#if defined(EMBREE_GEOMETRY_TRIANGLE)
+    candidates.push_back(AutoTuner::Candidate("bvh4.triangle4.sah", [&] () {
+          return device->bvh4_factory->BVH4Triangle4(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::FAST); }));
+    candidates.push_back(AutoTuner::Candidate("bvh4.triangle4.spatial", [&] () {
+          return device->bvh4_factory->BVH4Triangle4(this,BVHFactory::BuildVariant::HIGH_QUALITY,BVHFactory::IntersectVariant::FAST); }));
+#if defined (EMBREE_TARGET_SIMD8)
+    if (device->canUseAVX())
+    {
+      candidates.push_back(AutoTuner::Candidate("bvh8.triangle4.sah", [&] () {
+            return device->bvh8_factory->BVH8Triangle4(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::FAST); }));
+      candidates.push_back(AutoTuner::Candidate("bvh8.triangle4.spatial", [&] () {
+            return device->bvh8_factory->BVH8Triangle4(this,BVHFactory::BuildVariant::HIGH_QUALITY,BVHFactory::IntersectVariant::FAST); }));
+    }
+#endif
+#endif
+    return AutoTuner(this).select("triangle",candidates);
+  }
+
   void Scene::createTriangleMBAccel()
   {
 #if defined(EMBREE_GEOMETRY_TRIANGLE)
@@ -279,6 +312,7 @@ namespace embree
     else if (device->quad_accel == "bvh4.quad4v")       accels_add(device->bvh4_factory->BVH4Quad4v(this));
     else if (device->quad_accel == "bvh4.quad4i")       accels_add(device->bvh4_factory->BVH4Quad4i(this));
     else if (device->quad_accel == "qbvh4.quad4i")      accels_add(device->bvh4_factory->BVH4QuantizedQuad4i(this));
+    else if (device->quad_accel == "bvh4obb.quad4v")    accels_add(device->bvh4_factory->BVH4OBBQuad4v(this));
 
 #if defined (EMBREE_TARGET_SIMD8)
     else if (device->quad_accel == "bvh8.quad4v")       accels_add(device->bvh8_factory->BVH8Quad4v(this));
@@ -354,6 +388,7 @@ namespace embree
       }
     }
     else if (device->hair_accel == "bvh4obb.virtualcurve4v" ) accels_add(device->bvh4_factory->BVH4OBBVirtualCurve4v(this,BVHFactory::IntersectVariant::FAST));
+    else if (device->hair_accel == "bvh4obb.virtualcurve4q" ) accels_add(device->bvh4_factory->BVH4OBBVirtualCurve4q(this,BVHFactory::IntersectVariant::FAST));
     else if (device->hair_accel == "bvh4obb.virtualcurve4i" ) accels_add(device->bvh4_factory->BVH4OBBVirtualCurve4i(this,BVHFactory::IntersectVariant::FAST));
 #if defined (EMBREE_TARGET_SIMD8)
     else if (device->hair_accel == "bvh8obb.virtualcurve8v" ) accels_add(device->bvh8_factory->BVH8OBBVirtualCurve8v(this,BVHFactory::IntersectVariant::FAST));
@@ -550,6 +585,13 @@ namespace embree
 #endif
   }
 
+  void Scene::createFlattenedInstanceAccel()
+  {
+#if defined(EMBREE_GEOMETRY_TRIANGLE) && defined(EMBREE_GEOMETRY_INSTANCE)
+    accels_add(device->bvh4_factory->BVH4FlattenedInstance(this));
+#endif
+  }
+
   void Scene::createGridAccel()
   {
     BVHFactory::IntersectVariant ivariant = isRobustAccel() ? BVHFactory::IntersectVariant::ROBUST : BVHFactory::IntersectVariant::FAST;
@@ -577,6 +619,27 @@ namespace embree
 
   }
 
+  bool Scene::createMixedAccel()
+  {
+    /* a single BVH over all primitive types only pays off for static scenes with different primitive types */
+    if (!isStaticAccel() || isRobustAccel())
+      return false;
+    if (getNumPrimitives(Geometry::GTypeMask(-1),true))
+      return false;
+    if (getNumPrimitives(Geometry::GTypeMask(GridMesh::geom_type | SubdivMesh::geom_type),false))
+      return false;
+
+    const Geometry::GTypeMask types[] = { TriangleMesh::geom_type, QuadMesh::geom_type, Geometry::MTY_CURVES, UserGeometry::geom_type, Geometry::MTY_INSTANCE };
+    size_t numTypes = 0;
+    for (auto ty : types)
+      numTypes += getNumPrimitives(ty,false) != 0;
+    if (numTypes < 2)
+      return false;
+
+    accels_add(device->bvh4_factory->BVH4Mixed(this));
+    return true;
+  }
+
   void Scene::createGridMBAccel()
   {
 #if defined(EMBREE_GEOMETRY_GRID)
@@ -638,6 +701,27 @@ namespace embree
     geometryModCounters_[geomID] = 0;
   }
 
+  void Scene::updateInstanceLevels()
+  {
+    unsigned int levels = 0;
+    if (world.numInstancesCheap + world.numMBInstancesCheap + world.numInstancesExpensive + world.numMBInstancesExpensive)
+    {
+      for (size_t i=0; i<geometries.size(); i++)
+      {
+        Geometry* geom = geometries[i].ptr;
+        if (geom == nullptr || !geom->isEnabled() || !(geom->getTypeMask() & Geometry::MTY_INSTANCE)) continue;
+        const Scene* object = (const Scene*) ((Instance*)geom)->object;
+        if (object) levels = max(levels,object->instance_levels+1);
+      }
+    }
+
+    /* instances nested deeper than the instance ID stack would silently disappear */
+    if (levels > RTC_MAX_INSTANCE_LEVEL_COUNT)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene contains " + toString(levels) + " nested instance levels, but Embree got compiled with EMBREE_MAX_INSTANCE_LEVEL_COUNT=" + toString(RTC_MAX_INSTANCE_LEVEL_COUNT));
+    
+    instance_levels = levels;
+  }
+
   void Scene::updateInterface()
   {
     is_build = true;
@@ -646,9 +730,29 @@ namespace embree
   void Scene::commit_task ()
   {
     checkIfModifiedAndSet ();
+
+    /* build the acceleration structures of a lazily committed scene on its first visit */
+    if (lazy_pending.load() && !isModified())
+    {
+      commit_accels();
+
+      /* commit_accels resets the geometry modification counters, restore them such that a rebuild after eviction takes this path again */
+      parallel_for(geometries.size(), [&] ( const size_t i ) {
+          if (geometries[i] && geometries[i]->isEnabled())
+            geometryModCounters_[i] = geometries[i]->getModCounter();
+        });
+      lazy_epoch = device->lazyEpoch.load();
+      device->addLazyScene(this,bytesAllocated());
+      lazy_pending.store(false,std::memory_order_release);
+      return;
+    }
+    
     if (!isModified()) {
       return;
     }
+
+    /* the acceleration structures of a lazily built scene get registered again when rebuilt */
+    device->removeLazyScene(this);
     
     /* print scene statistics */
     if (device->verbosity(2))
@@ -674,12 +778,51 @@ namespace embree
       },
       std::plus<GeometryCounts>()
     );
-    
+
+    /* check that the instance ID stack is large enough for the scene */
+    updateInstanceLevels();
+
+    /* instances of this scene get culled for rays that mask out all its geometries */
+#if defined(EMBREE_RAY_MASK)
+    if (device->ray_mask_culling)
+    {
+      mask = parallel_reduce(size_t(0), geometries.size(), 0u, [&] (const range<size_t>& r) -> unsigned int {
+          unsigned int m = 0;
+          for (size_t i=r.begin(); i<r.end(); i++)
+            if (geometries[i] && geometries[i]->isEnabled())
+              m |= getCullingMask(geometries[i].ptr);
+          return m;
+        }, [] (unsigned int a, unsigned int b) { return a | b; });
+    }
+#endif
+
+    /* lazily built scenes only compute their bounds here */
+    const bool lazy = isLazyAccel() && commitLazy();
+    if (!lazy)
+      commit_accels();
+
+    /* call postCommit function of each geometry */
+    parallel_for(geometries.size(), [&] ( const size_t i ) {
+        if (geometries[i] && geometries[i]->isEnabled()) {
+          geometries[i]->postCommit();
+          vertices[i] = geometries[i]->getCompactVertexArray();
+          geometryModCounters_[i] = geometries[i]->getModCounter();
+        }
+      });
+      
+    updateInterface();
+    setModified(false);
+    lazy_pending.store(lazy,std::memory_order_release);
+  }
+
+  void Scene::commit_accels ()
+  {
     /* select acceleration structures to build */
     unsigned int new_enabled_geometry_types = world.enabledGeometryTypesMask();
     if (flags_modified || new_enabled_geometry_types != enabled_geometry_types)
     {
       accels_init();
+      accels_gtype.clear();
 
       /* we need to make all geometries modified, otherwise two level builder will 
         not rebuild currently not modified geometries */
@@ -687,23 +830,35 @@ namespace embree
           geometryModCounters_[i] = 0;
         });
       
-      if (getNumPrimitives(TriangleMesh::geom_type,false)) createTriangleAccel();
-      if (getNumPrimitives(TriangleMesh::geom_type,true)) createTriangleMBAccel();
-      if (getNumPrimitives(QuadMesh::geom_type,false)) createQuadAccel();
-      if (getNumPrimitives(QuadMesh::geom_type,true)) createQuadMBAccel();
-      if (getNumPrimitives(GridMesh::geom_type,false)) createGridAccel();
-      if (getNumPrimitives(GridMesh::geom_type,true)) createGridMBAccel();
-      if (getNumPrimitives(SubdivMesh::geom_type,false)) createSubdivAccel();
-      if (getNumPrimitives(SubdivMesh::geom_type,true)) createSubdivMBAccel();
-      if (getNumPrimitives(Geometry::MTY_CURVES,false)) createHairAccel();
-      if (getNumPrimitives(Geometry::MTY_CURVES,true)) createHairMBAccel();
-      if (getNumPrimitives(UserGeometry::geom_type,false)) createUserGeometryAccel();
-      if (getNumPrimitives(UserGeometry::geom_type,true)) createUserGeometryMBAccel();
-      if (getNumPrimitives(Geometry::MTY_INSTANCE_CHEAP,false)) createInstanceAccel();
-      if (getNumPrimitives(Geometry::MTY_INSTANCE_CHEAP,true)) createInstanceMBAccel();
-      if (getNumPrimitives(Geometry::MTY_INSTANCE_EXPENSIVE,false)) createInstanceExpensiveAccel();
-      if (getNumPrimitives(Geometry::MTY_INSTANCE_EXPENSIVE,true)) createInstanceExpensiveMBAccel();
-      
+      /* use a single BVH over all primitive types if enabled, otherwise one BVH per primitive type */
+      if (device->mixed_accel && createMixedAccel())
+      {
+        /* the mixed BVH contains static primitives of all types */
+        accels_gtype.resize(accels.size(),std::make_pair(Geometry::GTypeMask(-1),false));
+      }
+      else
+      {
+        createAccel(TriangleMesh::geom_type,false,&Scene::createTriangleAccel);
+        createAccel(TriangleMesh::geom_type,true,&Scene::createTriangleMBAccel);
+        createAccel(QuadMesh::geom_type,false,&Scene::createQuadAccel);
+        createAccel(QuadMesh::geom_type,true,&Scene::createQuadMBAccel);
+        createAccel(GridMesh::geom_type,false,&Scene::createGridAccel);
+        createAccel(GridMesh::geom_type,true,&Scene::createGridMBAccel);
+        createAccel(SubdivMesh::geom_type,false,&Scene::createSubdivAccel);
+        createAccel(SubdivMesh::geom_type,true,&Scene::createSubdivMBAccel);
+        createAccel(Geometry::MTY_CURVES,false,&Scene::createHairAccel);
+        createAccel(Geometry::MTY_CURVES,true,&Scene::createHairMBAccel);
+        createAccel(UserGeometry::geom_type,false,&Scene::createUserGeometryAccel);
+        createAccel(UserGeometry::geom_type,true,&Scene::createUserGeometryMBAccel);
+        createAccel(Geometry::MTY_INSTANCE_CHEAP,false,&Scene::createInstanceAccel);
+        createAccel(Geometry::MTY_INSTANCE_CHEAP,true,&Scene::createInstanceMBAccel);
+        createAccel(Geometry::MTY_INSTANCE_EXPENSIVE,false,&Scene::createInstanceExpensiveAccel);
+        createAccel(Geometry::MTY_INSTANCE_EXPENSIVE,true,&Scene::createInstanceExpensiveMBAccel);
+      }
+
+      /* triangles of small instanced scenes get copied into a separate BVH */
+      if (device->instancing_flatten_threshold) createAccel(Geometry::MTY_INSTANCE_CHEAP,false,&Scene::createFlattenedInstanceAccel);
+
       flags_modified = false;
       enabled_geometry_types = new_enabled_geometry_types;
     }
@@ -714,31 +869,108 @@ namespace embree
     /* build all hierarchies of this scene */
     accels_build();
 
+    /* rays skip acceleration structures whose geometries they all mask out */
+#if defined(EMBREE_RAY_MASK)
+    if (device->ray_mask_culling)
+      updateAccelMasks();
+#endif
+
     /* make static geometry immutable */
     if (!isDynamicAccel()) {
       accels_immutable();
       flags_modified = true; // in non-dynamic mode we have to re-create accels
     }
 
-    /* call postCommit function of each geometry */
-    parallel_for(geometries.size(), [&] ( const size_t i ) {
-        if (geometries[i] && geometries[i]->isEnabled()) {
-          geometries[i]->postCommit();
-          vertices[i] = geometries[i]->getCompactVertexArray();
-          geometryModCounters_[i] = geometries[i]->getModCounter();
-        }
-      });
-      
-    updateInterface();
-
     if (device->verbosity(2)) {
       std::cout << "created scene intersector" << std::endl;
       accels_print(2);
       std::cout << "selected scene intersector" << std::endl;
       intersectors.print(2);
     }
-    
-    setModified(false);
+  }
+
+  void Scene::createAccel(Geometry::GTypeMask gtype, bool mblur, void (Scene::*createAccelFunc)())
+  {
+    if (!getNumPrimitives(gtype,mblur)) return;
+    (this->*createAccelFunc)();
+    accels_gtype.resize(accels.size(),std::make_pair(gtype,mblur));
+  }
+
+  unsigned int Scene::getCullingMask(const Geometry* geom)
+  {
+    unsigned int m = geom->mask;
+    if (geom->getTypeMask() & Geometry::MTY_INSTANCE) {
+      const Accel* object = ((const Instance*)geom)->object;
+      if (object) m &= object->mask;
+    }
+    return m;
+  }
+
+  void Scene::updateAccelMasks()
+  {
+    std::vector<unsigned int> masks(accels.size(),0);
+    for (size_t i=0; i<geometries.size(); i++)
+    {
+      const Geometry* geom = geometries[i].ptr;
+      if (geom == nullptr || !geom->isEnabled()) continue;
+      const unsigned int m = getCullingMask(geom);
+      const bool mblur = geom->numTimeSteps > 1;
+      for (size_t j=0; j<accels.size(); j++)
+        if ((geom->getTypeMask() & accels_gtype[j].first) && mblur == accels_gtype[j].second)
+          masks[j] |= m;
+    }
+    for (size_t j=0; j<accels.size(); j++)
+      accels[j]->mask = masks[j];
+  }
+
+  bool Scene::commitLazy()
+  {
+    /* motion blur, grids, and subdivision surfaces always get built */
+    if (getNumPrimitives(Geometry::GTypeMask(-1),true))
+      return false;
+    if (getNumPrimitives(Geometry::GTypeMask(GridMesh::geom_type | SubdivMesh::geom_type),false))
+      return false;
+
+    /* bound the primitives the builders will see */
+    BBox3fa b = empty;
+    for (size_t i=0; i<geometries.size(); i++)
+    {
+      Geometry* geom = geometries[i].ptr;
+      if (geom == nullptr || !geom->isEnabled()) continue;
+      b.extend(parallel_reduce(size_t(0), geom->size(), size_t(1024), BBox3fa(empty), [&](const range<size_t>& r) -> BBox3fa {
+            mvector<PrimRef> prims(device,r.size());
+            return geom->createPrimRefArray(prims,r,0,unsigned(i)).geomBounds;
+          }, [] (const BBox3fa& a, const BBox3fa& b) { return merge(a,b); }));
+    }
+
+    /* free acceleration structures of a previous build */
+    accels_clear();
+    bounds = LBBox3fa(b);
+    return true;
+  }
+
+  void Scene::buildLazy()
+  {
+#if defined(TASKING_TBB) && (TBB_INTERFACE_VERSION_MAJOR < 8) || defined(TASKING_PPL)
+    Lock<MutexSys> lock(lazyMutex);
+    if (lazy_pending.load()) commit(false);
+#else
+    commit(true);
+#endif
+  }
+
+  bool Scene::evictLazy()
+  {
+    /* scenes that are currently getting built are kept */
+    if (!buildMutex.try_lock())
+      return false;
+
+    lazy_pending.store(true);
+    accels_clear();
+    for (auto& geometry : geometries)
+      if (geometry) geometry->pruneSharedAccels();
+    buildMutex.unlock();
+    return true;
   }
 
   void Scene::setBuildQuality(RTCBuildQuality quality_flags_i)
@@ -748,6 +980,10 @@ namespace embree
     flags_modified = true;
   }
 
+  void Scene::setFootprintDistanceFactor(float factor) {
+    footprintDistanceFactor = factor;
+  }
+
   RTCBuildQuality Scene::getBuildQuality() const {
     return quality_flags;
   }
@@ -755,8 +991,15 @@ namespace embree
   void Scene::setSceneFlags(RTCSceneFlags scene_flags_i)
   {
     if (scene_flags == scene_flags_i) return;
+
+    /* enabling statistics starts counting from zero */
+    if ((scene_flags_i & RTC_SCENE_FLAG_STATISTICS) && !(scene_flags & RTC_SCENE_FLAG_STATISTICS))
+      statistics.reset();
+
+    /* toggling statistics does not require new acceleration structures */
+    const bool accel_flags_modified = (scene_flags ^ scene_flags_i) & ~RTC_SCENE_FLAG_STATISTICS;
     scene_flags = scene_flags_i;
-    flags_modified = true;
+    if (accel_flags_modified) flags_modified = true;
   }
 
   RTCSceneFlags Scene::getSceneFlags() const {
@@ -904,7 +1147,7 @@ namespace embree
     Lock<MutexSys> lock(buildMutex);
 
     checkIfModifiedAndSet ();
-    if (!isModified()) {
+    if (!isModified() && !lazy_pending.load()) {
       return;
     }
 
@@ -934,6 +1177,95 @@ namespace embree
   }
 #endif
 
+  int Scene::getCommitStage (const Scene* scene, std::map<const Scene*,int>& stages, const std::set<const Scene*>& batch)
+  {
+    auto it = stages.find(scene);
+    if (it != stages.end()) {
+      if (it->second < 0)
+        throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"scenes instance each other recursively");
+      return it->second;
+    }
+
+    /* a scene has to get committed after all batch scenes it instances, also through scenes not part of the batch */
+    stages[scene] = -1;
+    int stage = 0;
+    for (size_t i=0; i<scene->size(); i++)
+    {
+      const Geometry* geom = scene->get(i);
+      if (geom == nullptr || !(geom->getTypeMask() & Geometry::MTY_INSTANCE)) continue;
+      const Scene* object = (const Scene*) ((const Instance*)geom)->object;
+      if (object == nullptr) continue;
+      const int childStage = getCommitStage(object,stages,batch);
+      stage = max(stage,batch.count(object) ? childStage+1 : childStage);
+    }
+    return stages[scene] = stage;
+  }
+
+  void Scene::commitScenes (Scene** scenes_i, size_t numScenes)
+  {
+    /* scenes get locked in address order to not deadlock with concurrent batch commits */
+    std::vector<Scene*> scenes(scenes_i,scenes_i+numScenes);
+    std::sort(scenes.begin(),scenes.end());
+    scenes.erase(std::unique(scenes.begin(),scenes.end()),scenes.end());
+    if (scenes.empty()) return;
+
+    /* group scenes into stages, scenes of the same stage get committed concurrently */
+    const std::set<const Scene*> batch(scenes.begin(),scenes.end());
+    std::map<const Scene*,int> stageOf;
+    std::vector<std::vector<Scene*>> stages;
+    for (Scene* scene : scenes) {
+      const size_t stage = getCommitStage(scene,stageOf,batch);
+      if (stage >= stages.size()) stages.resize(stage+1);
+      stages[stage].push_back(scene);
+    }
+
+    for (Scene* scene : scenes)
+      scene->buildMutex.lock();
+
+    auto commitStages = [&] () {
+      for (const std::vector<Scene*>& stage : stages)
+        parallel_for(stage.size(), [&] (const size_t i) { stage[i]->commit_task(); });
+    };
+
+    /* for best performance set FTZ and DAZ flags in the MXCSR control and status register */
+    const unsigned int mxcsr = _mm_getcsr();
+    _mm_setcsr(mxcsr | /* FTZ */ (1<<15) | /* DAZ */ (1<<6));
+
+    try {
+#if defined(TASKING_INTERNAL)
+      Ref<TaskScheduler> scheduler = new TaskScheduler;
+      scheduler->spawn_root([&]() { commitStages(); });
+#elif defined(TASKING_TBB)
+#if TBB_INTERFACE_VERSION_MAJOR < 8
+      tbb::task_group_context ctx( tbb::task_group_context::isolated, tbb::task_group_context::default_traits);
+#else
+      tbb::task_group_context ctx( tbb::task_group_context::isolated, tbb::task_group_context::default_traits | tbb::task_group_context::fp_settings );
+#endif
+      tbb::parallel_for (size_t(0), size_t(1), size_t(1), [&] (size_t) { commitStages(); }, ctx);
+#else
+      commitStages();
+#endif
+
+      /* reset MXCSR register again */
+      _mm_setcsr(mxcsr);
+    }
+    catch (...)
+    {
+      /* reset MXCSR register again */
+      _mm_setcsr(mxcsr);
+
+      for (Scene* scene : scenes) {
+        scene->accels_clear();
+        scene->updateInterface();
+        scene->buildMutex.unlock();
+      }
+      throw;
+    }
+
+    for (Scene* scene : scenes)
+      scene->buildMutex.unlock();
+  }
+
   void Scene::setProgressMonitorFunction(RTCProgressMonitorFunction func, void* ptr) 
   {
     progress_monitor_function = func;
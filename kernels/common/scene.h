@@ -19,8 +19,12 @@
 #include "../subdiv/tessellation_cache.h"
 
 #include "acceln.h"
+#include "scene_statistics.h"
 #include "geometry.h"
 
+#include <map>
+#include <set>
+
 namespace embree
 {
   /*! Base class all scenes are derived from */
@@ -146,6 +150,7 @@ namespace embree
 
   public:
     void createTriangleAccel();
+    Accel* autotuneTriangleAccel();
     void createTriangleMBAccel();
     void createQuadAccel();
     void createQuadMBAccel();
@@ -159,8 +164,22 @@ namespace embree
     void createInstanceMBAccel();
     void createInstanceExpensiveAccel();
     void createInstanceExpensiveMBAccel();
+    void createFlattenedInstanceAccel();
+
+    /* determines the number of nested instance levels of the scene */
+    void updateInstanceLevels();
     void createGridAccel();
     void createGridMBAccel();
+    bool createMixedAccel();
+
+    /*! creates the acceleration structure for some primitive type if the scene contains such primitives */
+    void createAccel(Geometry::GTypeMask gtype, bool mblur, void (Scene::*createAccelFunc)());
+
+    /*! returns the ray mask of a geometry, instances are restricted to the mask of the instanced scene */
+    static unsigned int getCullingMask(const Geometry* geom);
+
+    /*! sets the mask of each acceleration structure to the OR-ed masks of its geometries */
+    void updateAccelMasks();
 
     /*! prints statistics about the scene */
     void printStatistics();
@@ -173,14 +192,44 @@ namespace embree
 
     void setBuildQuality(RTCBuildQuality quality_flags);
     RTCBuildQuality getBuildQuality() const;
+
+    void setFootprintDistanceFactor(float factor);
     
     void setSceneFlags(RTCSceneFlags scene_flags);
     RTCSceneFlags getSceneFlags() const;
     
     void commit (bool join);
     void commit_task ();
+    void commit_accels ();
     void build () {}
 
+    /*! commits multiple scenes concurrently, instanced scenes get committed before the scenes instancing them */
+    static void commitScenes (Scene** scenes, size_t numScenes);
+
+  private:
+    /*! returns the commit stage of a scene of a batch commit, scenes of a stage only instance scenes of previous stages */
+    static int getCommitStage (const Scene* scene, std::map<const Scene*,int>& stages, const std::set<const Scene*>& batch);
+
+  public:
+
+    /*! computes the bounds of a lazily built scene, returns false if the scene requires a regular build */
+    bool commitLazy();
+
+    /*! builds the acceleration structures of a lazily committed scene, visiting threads join the build */
+    void buildLazy();
+
+    /*! frees the acceleration structures of a lazily built scene, they get rebuilt on the next visit */
+    bool evictLazy();
+
+    /*! builds the acceleration structures of a lazily committed scene on its first visit */
+    __forceinline void visitLazy()
+    {
+      if (likely(!isLazyAccel())) return;
+      if (unlikely(lazy_pending.load(std::memory_order_acquire))) buildLazy();
+      const size_t epoch = device->lazyEpoch.load(std::memory_order_relaxed);
+      if (lazy_epoch.load(std::memory_order_relaxed) != epoch) lazy_epoch.store(epoch,std::memory_order_relaxed);
+    }
+
     void updateInterface();
 
     /* return number of geometries */
@@ -258,6 +307,7 @@ namespace embree
     __forceinline bool isRobustAccel()  const { return scene_flags & RTC_SCENE_FLAG_ROBUST; }
     __forceinline bool isStaticAccel()  const { return !(scene_flags & RTC_SCENE_FLAG_DYNAMIC); }
     __forceinline bool isDynamicAccel() const { return scene_flags & RTC_SCENE_FLAG_DYNAMIC; }
+    __forceinline bool isLazyAccel()    const { return scene_flags & RTC_SCENE_FLAG_LAZY_BUILD; }
     
     __forceinline bool hasContextFilterFunction() const {
       return scene_flags & RTC_SCENE_FLAG_CONTEXT_FILTER_FUNCTION;
@@ -270,6 +320,15 @@ namespace embree
     __forceinline bool hasFilterFunction() {
       return hasContextFilterFunction() || hasGeometryFilterFunction();
     }
+
+    __forceinline bool hasStatistics() const {
+      return scene_flags & RTC_SCENE_FLAG_STATISTICS;
+    }
+
+    /* returns the traversal statistics or NULL if statistics are disabled */
+    __forceinline SceneStatistics* getStatistics() {
+      return hasStatistics() ? &statistics : nullptr;
+    }
     
     /* test if scene got already build */
     __forceinline bool isBuild() const { return is_build; }
@@ -289,9 +348,16 @@ namespace embree
     
     RTCSceneFlags scene_flags;
     RTCBuildQuality quality_flags;
+    float footprintDistanceFactor;   //!< ray footprint width as factor of the distance to the ray origin, 0 disables footprint based curve intersection
+    SceneStatistics statistics;      //!< traversal counters, gathered if RTC_SCENE_FLAG_STATISTICS is set
     MutexSys buildMutex;
     SpinLock geometriesMutex;
     bool is_build;
+    unsigned int instance_levels;    //!< number of nested instance levels of the scene
+    std::atomic<bool> lazy_pending;  //!< true if the acceleration structures of a lazily committed scene still need to get built
+    std::atomic<size_t> lazy_epoch;  //!< frame epoch of the last visit of a lazily built scene
+    MutexSys lazyMutex;              //!< serializes lazy builds if joining a build is not supported
+    std::vector<std::pair<Geometry::GTypeMask,bool>> accels_gtype; //!< primitive types and motion blur of the geometries of each acceleration structure
   private:
     bool modified;                   //!< true if scene got modified
 
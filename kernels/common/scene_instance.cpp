@@ -133,6 +133,20 @@ namespace embree
     Geometry::commit();
   }
 
+  bool Instance::isFlattened() const
+  {
+    const size_t threshold = device->instancing_flatten_threshold;
+    if (threshold == 0 || object == nullptr)
+      return false;
+    if (gtype != GTY_INSTANCE_CHEAP || numTimeSteps != 1)
+      return false;
+
+    /* only static triangle meshes get flattened */
+    const Scene* scene = (const Scene*) object;
+    const size_t numTriangles = scene->getNumPrimitives(Geometry::MTY_TRIANGLE_MESH,false);
+    return numTriangles != 0 && numTriangles <= threshold && numTriangles == scene->numPrimitives();
+  }
+
   /* 
 
      This function calculates the correction for the linear bounds
@@ -103,6 +103,9 @@ namespace embree
       return isvalid(bounds);
     }
 
+    /*! returns true if the instanced scene is small enough to get copied into the leaves of the instancing scene */
+    bool isFlattened() const;
+
     /* gets version info of topology */
     unsigned int getTopologyVersion() const {
       return numPrimitives;
@@ -226,6 +229,7 @@ namespace embree
         assert(r.end()   == 1);
 
         PrimInfo pinfo(empty);
+        if (isFlattened()) return pinfo;
         BBox3fa b = empty;
         if (!buildBounds(0,&b)) return pinfo;
         // const BBox3fa b = bounds(0);
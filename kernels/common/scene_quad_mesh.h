@@ -330,6 +330,29 @@ namespace embree
         }
         return pinfo;
       }
+
+      Vec3fa computeDirection(unsigned int primID) const
+      {
+        /* the longer diagonal is the dominant direction of thin quads */
+        const Quad& q = quad(primID);
+        const Vec3fa d0 = vertex(q.v[2])-vertex(q.v[0]);
+        const Vec3fa d1 = vertex(q.v[3])-vertex(q.v[1]);
+        return dot(d0,d0) >= dot(d1,d1) ? d0 : d1;
+      }
+
+      BBox3fa vbounds(size_t i) const {
+        return bounds(i);
+      }
+
+      BBox3fa vbounds(const LinearSpace3fa& space, size_t i) const
+      {
+        const Quad& q = quad(i);
+        const Vec3fa v0 = xfmPoint(space,vertex(q.v[0]));
+        const Vec3fa v1 = xfmPoint(space,vertex(q.v[1]));
+        const Vec3fa v2 = xfmPoint(space,vertex(q.v[2]));
+        const Vec3fa v3 = xfmPoint(space,vertex(q.v[3]));
+        return BBox3fa(min(v0,v1,v2,v3),max(v0,v1,v2,v3));
+      }
     };
   }
 
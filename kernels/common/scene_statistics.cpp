@@ -0,0 +1,62 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "scene_statistics.h"
+#include "../geometry/primitive.h"
+
+namespace embree
+{
+  /* threads get assigned counter slots in round robin order */
+  static std::atomic<size_t> g_statistics_slot_counter(0);
+  static __thread size_t g_statistics_slot = size_t(-1);
+
+  static __forceinline size_t threadSlot()
+  {
+    if (unlikely(g_statistics_slot == size_t(-1)))
+      g_statistics_slot = g_statistics_slot_counter++ % SceneStatistics::NUM_SLOTS;
+    return g_statistics_slot;
+  }
+
+  void SceneStatistics::add(size_t nodeVisits, size_t leafVisits, size_t primitiveTests)
+  {
+    Slot& slot = slots[threadSlot()];
+    slot.nodeVisits.fetch_add(nodeVisits,std::memory_order_relaxed);
+    slot.leafVisits.fetch_add(leafVisits,std::memory_order_relaxed);
+    slot.primitiveTests.fetch_add(primitiveTests,std::memory_order_relaxed);
+  }
+
+  size_t SceneStatistics::countPrimitives(const PrimitiveType* primTy, const char* prim, size_t num)
+  {
+    primTy = primTy->leafType(prim,num);
+    size_t numPrimitives = 0;
+    for (size_t i=0; i<num; i++) {
+      numPrimitives += primTy->sizeActive(prim);
+      prim += primTy->getBytes(prim);
+    }
+    return numPrimitives;
+  }
+
+  void SceneStatistics::addFilterCall() {
+    slots[threadSlot()].filterCalls.fetch_add(1,std::memory_order_relaxed);
+  }
+
+  void SceneStatistics::get(RTCSceneStatistics& stats_o) const
+  {
+    stats_o.nodeVisits = 0;
+    stats_o.leafVisits = 0;
+    stats_o.primitiveTests = 0;
+    stats_o.filterCalls = 0;
+    for (size_t i=0; i<NUM_SLOTS; i++) {
+      stats_o.nodeVisits     += slots[i].nodeVisits.load();
+      stats_o.leafVisits     += slots[i].leafVisits.load();
+      stats_o.primitiveTests += slots[i].primitiveTests.load();
+      stats_o.filterCalls    += slots[i].filterCalls.load();
+    }
+  }
+
+  void SceneStatistics::reset()
+  {
+    for (size_t i=0; i<NUM_SLOTS; i++)
+      slots[i].reset();
+  }
+}
@@ -0,0 +1,118 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "default.h"
+
+namespace embree
+{
+  struct PrimitiveType;
+
+  /*! Traversal counters of a scene that can get enabled at runtime
+   *  through the RTC_SCENE_FLAG_STATISTICS scene flag. Each thread
+   *  accumulates into its own cache line to avoid contention. */
+  class SceneStatistics
+  {
+  public:
+
+    static const size_t NUM_SLOTS = 64;   //!< number of per thread counter slots
+
+    /*! counters of one thread */
+    struct Slot
+    {
+      ALIGNED_STRUCT_(64);
+
+      Slot () { reset(); }
+
+      void reset()
+      {
+        nodeVisits.store(0);
+        leafVisits.store(0);
+        primitiveTests.store(0);
+        filterCalls.store(0);
+      }
+
+    public:
+      std::atomic<size_t> nodeVisits;       //!< number of inner nodes visited, per ray
+      std::atomic<size_t> leafVisits;       //!< number of leaf nodes visited, per ray
+      std::atomic<size_t> primitiveTests;   //!< number of primitives tested, per ray
+      std::atomic<size_t> filterCalls;      //!< number of filter function invocations
+      char align[64-4*sizeof(std::atomic<size_t>)];
+    };
+
+  public:
+
+    /*! adds counters of a single traversal to the slot of the calling thread */
+    void add(size_t nodeVisits, size_t leafVisits, size_t primitiveTests);
+
+    /*! returns the number of active primitives stored in the num primitive blocks of a leaf */
+    static size_t countPrimitives(const PrimitiveType* primTy, const char* prim, size_t num);
+
+    /*! records a filter function invocation */
+    void addFilterCall();
+
+    /*! sums up the counters of all threads */
+    void get(RTCSceneStatistics& stats_o) const;
+
+    /*! clears all counters */
+    void reset();
+
+  private:
+    Slot slots[NUM_SLOTS];
+  };
+
+  /*! Accumulates counters of a single traversal in registers and
+   *  flushes them to the scene statistics on destruction. All counts
+   *  are per ray, packet and stream traversal count each visit once
+   *  per active ray. When statistics are disabled each visit only
+   *  tests the statistics pointer. */
+  struct TraversalCounters
+  {
+    __forceinline TraversalCounters (SceneStatistics* stats)
+      : stats(stats), nodeVisits(0), leafVisits(0), primitiveTests(0) {}
+
+    __forceinline ~TraversalCounters()
+    {
+      if (unlikely(stats))
+        stats->add(nodeVisits,leafVisits,primitiveTests);
+    }
+
+    /*! records an inner node visit of a single ray */
+    __forceinline void node() {
+      if (unlikely(stats)) nodeVisits++;
+    }
+
+    /*! records an inner node visit of all active rays of a packet or stream */
+    template<typename Mask>
+    __forceinline void node(const Mask& active) {
+      if (unlikely(stats)) nodeVisits += popcnt(active);
+    }
+
+    /*! records a leaf visit of a single ray, the leaf stores num primitive blocks of type primTy */
+    __forceinline void leaf(const PrimitiveType* primTy, const char* prim, size_t num)
+    {
+      if (unlikely(stats)) {
+        leafVisits++;
+        primitiveTests += SceneStatistics::countPrimitives(primTy,prim,num);
+      }
+    }
+
+    /*! records a leaf visit of all active rays of a packet or stream */
+    template<typename Mask>
+    __forceinline void leaf(const PrimitiveType* primTy, const char* prim, size_t num, const Mask& active)
+    {
+      if (unlikely(stats)) {
+        const size_t numRays = popcnt(active);
+        leafVisits += numRays;
+        primitiveTests += numRays*SceneStatistics::countPrimitives(primTy,prim,num);
+      }
+    }
+
+  private:
+    SceneStatistics* stats;
+    size_t nodeVisits;
+    size_t leafVisits;
+    size_t primitiveTests;
+  };
+}
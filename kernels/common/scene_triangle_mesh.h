@@ -311,6 +311,33 @@ namespace embree
         }
         return pinfo;
       }
+
+      Vec3fa computeDirection(unsigned int primID) const
+      {
+        /* the longest edge is the dominant direction of thin triangles */
+        const Triangle& tri = triangle(primID);
+        const Vec3fa v0 = vertex(tri.v[0]);
+        const Vec3fa v1 = vertex(tri.v[1]);
+        const Vec3fa v2 = vertex(tri.v[2]);
+        const Vec3fa e0 = v1-v0, e1 = v2-v1, e2 = v0-v2;
+        const float l0 = dot(e0,e0), l1 = dot(e1,e1), l2 = dot(e2,e2);
+        if (l0 >= l1 && l0 >= l2) return e0;
+        if (l1 >= l2) return e1;
+        return e2;
+      }
+
+      BBox3fa vbounds(size_t i) const {
+        return bounds(i);
+      }
+
+      BBox3fa vbounds(const LinearSpace3fa& space, size_t i) const
+      {
+        const Triangle& tri = triangle(i);
+        const Vec3fa v0 = xfmPoint(space,vertex(tri.v[0]));
+        const Vec3fa v1 = xfmPoint(space,vertex(tri.v[1]));
+        const Vec3fa v2 = xfmPoint(space,vertex(tri.v[2]));
+        return BBox3fa(min(v0,v1,v2),max(v0,v1,v2));
+      }
     };
   }
 
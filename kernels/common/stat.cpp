@@ -115,6 +115,15 @@ namespace embree
     }
     cout << std::endl;
 
+    /* print node visits per ray of coherent ray streams */
+    if (cntrs.all.normal.trav_stream_rays) {
+      cout << "--------- STREAM ---------" << std::endl;
+      cout << "  #stream_rays    = " << float(cntrs.active.normal.trav_stream_rays)*1E-6 << "M in " << float(cntrs.code.normal.trav_stream_rays)*1E-6 << "M streams" << std::endl;
+      cout << "    #nodes        = " << float(cntrs.code.normal.trav_stream_nodes)/float(cntrs.code.normal.trav_stream_rays) << " per stream" << std::endl;
+      cout << "    #nodes_ray    = " << float(cntrs.active.normal.trav_stream_nodes)/float(cntrs.active.normal.trav_stream_rays) << " per ray" << std::endl;
+      cout << std::endl;
+    }
+
      /* print user counters for performance tuning */
     cout << "--------- USER ---------" << std::endl;
     for (size_t i=0; i<10; i++)
@@ -76,6 +76,8 @@ namespace embree
               trav_stack_pop.store(0);
               trav_stack_nodes.store(0); 
               trav_xfm_nodes.store(0); 
+              trav_stream_rays.store(0);
+              trav_stream_nodes.store(0);
             }
 
           public:
@@ -88,6 +90,8 @@ namespace embree
 	    std::atomic<size_t> trav_stack_pop;
 	    std::atomic<size_t> trav_stack_nodes; 
             std::atomic<size_t> trav_xfm_nodes; 
+            std::atomic<size_t> trav_stream_rays;    //!< coherent ray streams traced, active counts rays
+            std::atomic<size_t> trav_stream_nodes;   //!< node visits of coherent ray streams, active counts rays visiting
             
 	  } normal, shadow, point_query;
 	} all, active, code; 
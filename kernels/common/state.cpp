@@ -42,6 +42,8 @@ namespace embree
     tri_accel = "default";
     tri_builder = "default";
     tri_traverser = "default";
+    medium_quality_builder = "default";
+    ploc_search_radius = 8;
     
     tri_accel_mb = "default";
     tri_builder_mb = "default";
@@ -82,6 +84,7 @@ namespace embree
     object_accel_mb_max_leaf_size = 1;
 
     max_spatial_split_replications = 1.2f;
+    mblur_refit_threshold = 1.5f;
     useSpatialPreSplits = false;
 
     tessellation_cache_size = 128*1024*1024;
@@ -99,6 +102,21 @@ namespace embree
     instancing_open_factor = 8.0f; 
     instancing_open_max_depth = 32;
     instancing_open_max = 50000000;
+    instancing_flatten_threshold = 0;
+    lazy_build_memory_budget = 0;
+
+    mixed_accel = false;
+    ray_mask_culling = false;
+
+    autotune = false;
+    autotune_cache = "";
+    autotune_samples = 4096;
+    autotune_rays_per_build = 1000000;
+
+    packet_switch_threshold = -1;
+    packet_switch_adaptive = false;
+    packet_statistics = false;
+    stream_average_order = false;
 
     float_exceptions = false;
     quality_flags = -1;
@@ -301,6 +319,13 @@ namespace embree
         tri_builder = cin->get().Identifier();
       else if ((tok == Token::Id("tri_traverser") || tok == Token::Id("traverser")) && cin->trySymbol("="))
         tri_traverser = cin->get().Identifier();
+      else if (tok == Token::Id("medium_quality_builder") && cin->trySymbol("="))
+        medium_quality_builder = cin->get().Identifier();
+      else if (tok == Token::Id("ploc_search_radius") && cin->trySymbol("=")) {
+        const int radius = cin->get().Int();
+        if (radius < 0) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"ploc_search_radius has to be positive");
+        ploc_search_radius = max(radius,1);
+      }
      
       else if ((tok == Token::Id("tri_accel_mb") || tok == Token::Id("accel_mb")) && cin->trySymbol("="))
         tri_accel_mb = cin->get().Identifier();
@@ -383,6 +408,32 @@ namespace embree
       }
       else if (tok == Token::Id("instancing_open_max") && cin->trySymbol("="))
         instancing_open_max = cin->get().Int();
+      else if (tok == Token::Id("instancing_flatten_threshold") && cin->trySymbol("="))
+        instancing_flatten_threshold = cin->get().Int();
+      else if (tok == Token::Id("lazy_build_memory_budget") && cin->trySymbol("="))
+        lazy_build_memory_budget = size_t(cin->get().Int())*size_t(1024*1024);
+
+      else if (tok == Token::Id("mixed_accel") && cin->trySymbol("="))
+        mixed_accel = cin->get().Int();
+      else if (tok == Token::Id("ray_mask_culling") && cin->trySymbol("="))
+        ray_mask_culling = cin->get().Int();
+      else if (tok == Token::Id("autotune") && cin->trySymbol("="))
+        autotune = cin->get().Int();
+      else if (tok == Token::Id("autotune_cache") && cin->trySymbol("="))
+        autotune_cache = cin->get().String();
+      else if (tok == Token::Id("autotune_samples") && cin->trySymbol("="))
+        autotune_samples = cin->get().Int();
+      else if (tok == Token::Id("autotune_rays_per_build") && cin->trySymbol("="))
+        autotune_rays_per_build = cin->get().Int();
+
+      else if (tok == Token::Id("packet_switch_threshold") && cin->trySymbol("="))
+        packet_switch_threshold = cin->get().Int();
+      else if (tok == Token::Id("packet_switch_adaptive") && cin->trySymbol("="))
+        packet_switch_adaptive = cin->get().Int();
+      else if (tok == Token::Id("packet_statistics") && cin->trySymbol("="))
+        packet_statistics = cin->get().Int();
+      else if (tok == Token::Id("stream_average_order") && cin->trySymbol("="))
+        stream_average_order = cin->get().Int();
 
       else if (tok == Token::Id("subdiv_accel") && cin->trySymbol("="))
         subdiv_accel = cin->get().Identifier();
@@ -422,6 +473,8 @@ namespace embree
       
       else if (tok == Token::Id("max_spatial_split_replications") && cin->trySymbol("="))
         max_spatial_split_replications = cin->get().Float();
+      else if (tok == Token::Id("mblur_refit_threshold") && cin->trySymbol("="))
+        mblur_refit_threshold = cin->get().Float();
 
       else if (tok == Token::Id("presplits") && cin->trySymbol("="))
         useSpatialPreSplits = cin->get().Int() != 0 ? true : false;
@@ -471,11 +524,24 @@ namespace embree
     std::cout << "  verbosity          = " << verbose << std::endl;
     std::cout << "  cache_size         = " << float(tessellation_cache_size)*1E-6 << " MB" << std::endl;
     std::cout << "  max_spatial_split_replications = " << max_spatial_split_replications << std::endl;
+    std::cout << "  mblur_refit_threshold = " << mblur_refit_threshold << std::endl;
+    std::cout << "  instancing_flatten_threshold = " << instancing_flatten_threshold << std::endl;
+    std::cout << "  lazy_build_memory_budget = " << lazy_build_memory_budget/(1024*1024) << " MB" << std::endl;
+    std::cout << "  mixed_accel        = " << mixed_accel << std::endl;
+    std::cout << "  ray_mask_culling   = " << ray_mask_culling << std::endl;
+    std::cout << "  autotune           = " << autotune << std::endl;
+    std::cout << "  autotune_cache     = " << autotune_cache << std::endl;
+    std::cout << "  packet_switch_threshold = " << packet_switch_threshold << std::endl;
+    std::cout << "  packet_switch_adaptive  = " << packet_switch_adaptive << std::endl;
+    std::cout << "  packet_statistics  = " << packet_statistics << std::endl;
+    std::cout << "  stream_average_order = " << stream_average_order << std::endl;
     
     std::cout << "triangles:" << std::endl;
     std::cout << "  accel              = " << tri_accel << std::endl;
     std::cout << "  builder            = " << tri_builder << std::endl;
     std::cout << "  traverser          = " << tri_traverser << std::endl;
+    std::cout << "  medium_quality_builder = " << medium_quality_builder << std::endl;
+    std::cout << "  ploc_search_radius = " << ploc_search_radius << std::endl;
         
     std::cout << "motion blur triangles:" << std::endl;
     std::cout << "  accel              = " << tri_accel_mb << std::endl;
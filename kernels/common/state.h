@@ -47,6 +47,8 @@ namespace embree
     std::string tri_accel;                 //!< acceleration structure to use for triangles
     std::string tri_builder;               //!< builder to use for triangles
     std::string tri_traverser;             //!< traverser to use for triangles
+    std::string medium_quality_builder;    //!< builder to use for geometries with medium build quality in dynamic scenes
+    size_t ploc_search_radius;             //!< search radius of PLOC builder
     
   public:
     std::string tri_accel_mb;              //!< acceleration structure to use for motion blur triangles
@@ -109,6 +111,7 @@ namespace embree
     float max_spatial_split_replications;  //!< maximally replications*N many primitives in accel for spatial splits
     bool useSpatialPreSplits;              //!< use spatial pre-splits instead of the full spatial split builder
     size_t tessellation_cache_size;        //!< size of the shared tessellation cache 
+    float mblur_refit_threshold;           //!< motion blur BVH is rebuilt when refitting increased its SAH cost by more than this factor
 
   public:
     size_t instancing_open_min;            //!< instancing opens tree to minimally that number of subtrees
@@ -116,6 +119,24 @@ namespace embree
     float  instancing_open_factor;         //!< instancing opens tree up to x times the number of instances
     size_t instancing_open_max_depth;      //!< maximum open depth for geometries
     size_t instancing_open_max;            //!< instancing opens tree to maximally that number of subtrees
+    size_t instancing_flatten_threshold;   //!< instances of scenes with up to that number of triangles get copied into the instancing scene
+    size_t lazy_build_memory_budget;       //!< memory budget in bytes for lazily built scenes, 0 for no budget
+
+  public:
+    bool mixed_accel;                      //!< builds a single BVH with typed leaves over all static primitive types
+    bool ray_mask_culling;                 //!< culls acceleration structures and instances whose geometries are all masked out by a ray
+
+  public:
+    bool autotune;                         //!< selects acceleration structure by building and tracing candidate configurations
+    std::string autotune_cache;            //!< file to cache auto-tuned configurations in
+    size_t autotune_samples;               //!< number of rays to trace for each candidate configuration
+    size_t autotune_rays_per_build;        //!< number of rays expected to get traced per build to weight build against trace time
+
+  public:
+    int packet_switch_threshold;           //!< packets switch to single ray traversal at that many active rays, -1 uses the built-in threshold
+    bool packet_switch_adaptive;           //!< adapts the packet switch threshold to the measured SIMD efficiency of each packet
+    bool packet_statistics;                //!< collects packet traversal statistics readable as device properties
+    bool stream_average_order;             //!< orders children in coherent stream traversal by average instead of minimal entry distance
 
   public:
     bool float_exceptions;                 //!< enable floating point exceptions
@@ -116,6 +116,20 @@ namespace embree
       }
       return bvh->encodeLeaf((char*)accel,items);
     };
+
+    /*! gathers the control points of the i'th curve */
+    __forceinline void gather(Vec3ff& p0, Vec3ff& p1, Vec3ff& p2, Vec3ff& p3, const CurveGeometry* geom, size_t i, size_t N) const {
+      geom->gather(p0,p1,p2,p3,geom->curve(primID(N)[i]));
+    }
+
+    /*! prefetches the control points of the i'th curve */
+    __forceinline void prefetchL1_vertices(const CurveGeometry* geom, size_t i, size_t N) const {
+      geom->prefetchL1_vertices(geom->curve(primID(N)[i]));
+    }
+
+    __forceinline void prefetchL2_vertices(const CurveGeometry* geom, size_t i, size_t N) const {
+      geom->prefetchL2_vertices(geom->curve(primID(N)[i]));
+    }
     
   public:
     
@@ -49,8 +49,9 @@ namespace embree
         return (vint<M>(step) < vint<M>(prim.N)) & (tNear <= tFar);
       }
 
-      template<typename Intersector, typename Epilog>
-        static __forceinline void intersect_t(const Precalculations& pre, RayHit& ray, IntersectContext* context, const Primitive& prim)
+      /* the control points are fetched through the leaf, which lets CurveNq share this code */
+      template<typename Intersector, typename Epilog, typename Prim>
+        static __forceinline void intersect_leaf_t(const Precalculations& pre, RayHit& ray, IntersectContext* context, const Prim& prim)
       {
         vfloat<M> tNear;
         vbool<M> valid = intersect(ray,prim,tNear);
@@ -64,17 +65,15 @@ namespace embree
           const unsigned int geomID = prim.geomID(N);
           const unsigned int primID = prim.primID(N)[i];
           const CurveGeometry* geom = context->scene->get<CurveGeometry>(geomID);
-          Vec3ff a0,a1,a2,a3; geom->gather(a0,a1,a2,a3,geom->curve(primID));
+          Vec3ff a0,a1,a2,a3; prim.gather(a0,a1,a2,a3,geom,i,N);
 
           size_t mask1 = mask;
           const size_t i1 = bscf(mask1);
           if (mask) {
-            const unsigned int primID1 = prim.primID(N)[i1];
-            geom->prefetchL1_vertices(geom->curve(primID1));
+            prim.prefetchL1_vertices(geom,i1,N);
             if (mask1) {
               const size_t i2 = bsf(mask1);
-              const unsigned int primID2 = prim.primID(N)[i2];
-              geom->prefetchL2_vertices(geom->curve(primID2));
+              prim.prefetchL2_vertices(geom,i2,N);
             }
           }
           
@@ -84,7 +83,12 @@ namespace embree
       }
 
       template<typename Intersector, typename Epilog>
-        static __forceinline bool occluded_t(const Precalculations& pre, Ray& ray, IntersectContext* context, const Primitive& prim)
+        static __forceinline void intersect_t(const Precalculations& pre, RayHit& ray, IntersectContext* context, const Primitive& prim) {
+        intersect_leaf_t<Intersector,Epilog>(pre,ray,context,prim);
+      }
+
+      template<typename Intersector, typename Epilog, typename Prim>
+        static __forceinline bool occluded_leaf_t(const Precalculations& pre, Ray& ray, IntersectContext* context, const Prim& prim)
       {
         vfloat<M> tNear;
         vbool<M> valid = intersect(ray,prim,tNear);
@@ -98,17 +102,15 @@ namespace embree
           const unsigned int geomID = prim.geomID(N);
           const unsigned int primID = prim.primID(N)[i];
           const CurveGeometry* geom = context->scene->get<CurveGeometry>(geomID);
-          Vec3ff a0,a1,a2,a3; geom->gather(a0,a1,a2,a3,geom->curve(primID));
+          Vec3ff a0,a1,a2,a3; prim.gather(a0,a1,a2,a3,geom,i,N);
          
           size_t mask1 = mask;
           const size_t i1 = bscf(mask1);
           if (mask) {
-            const unsigned int primID1 = prim.primID(N)[i1];
-            geom->prefetchL1_vertices(geom->curve(primID1));
+            prim.prefetchL1_vertices(geom,i1,N);
             if (mask1) {
               const size_t i2 = bsf(mask1);
-              const unsigned int primID2 = prim.primID(N)[i2];
-              geom->prefetchL2_vertices(geom->curve(primID2));
+              prim.prefetchL2_vertices(geom,i2,N);
             }
           }
 
@@ -120,6 +122,11 @@ namespace embree
         return false;
       }
 
+      template<typename Intersector, typename Epilog>
+        static __forceinline bool occluded_t(const Precalculations& pre, Ray& ray, IntersectContext* context, const Primitive& prim) {
+        return occluded_leaf_t<Intersector,Epilog>(pre,ray,context,prim);
+      }
+
       template<typename Intersector, typename Epilog>
         static __forceinline void intersect_n(const Precalculations& pre, RayHit& ray, IntersectContext* context, const Primitive& prim)
       {
@@ -329,8 +336,9 @@ namespace embree
         return (vint<M>(step) < vint<M>(prim.N)) & (tNear <= tFar);
       }
       
-      template<typename Intersector, typename Epilog>
-        static __forceinline void intersect_t(Precalculations& pre, RayHitK<K>& ray, const size_t k, IntersectContext* context, const Primitive& prim)
+      /* the control points are fetched through the leaf, which lets CurveNq share this code */
+      template<typename Intersector, typename Epilog, typename Prim>
+        static __forceinline void intersect_leaf_t(Precalculations& pre, RayHitK<K>& ray, const size_t k, IntersectContext* context, const Prim& prim)
       {
         vfloat<M> tNear;
         vbool<M> valid = intersect(ray,k,prim,tNear);
@@ -344,17 +352,15 @@ namespace embree
           const unsigned int geomID = prim.geomID(N);
           const unsigned int primID = prim.primID(N)[i];
           const CurveGeometry* geom = context->scene->get<CurveGeometry>(geomID);
-          Vec3ff a0,a1,a2,a3; geom->gather(a0,a1,a2,a3,geom->curve(primID));
+          Vec3ff a0,a1,a2,a3; prim.gather(a0,a1,a2,a3,geom,i,N);
 
           size_t mask1 = mask;
           const size_t i1 = bscf(mask1);
           if (mask) {
-            const unsigned int primID1 = prim.primID(N)[i1];
-            geom->prefetchL1_vertices(geom->curve(primID1));
+            prim.prefetchL1_vertices(geom,i1,N);
             if (mask1) {
               const size_t i2 = bsf(mask1);
-              const unsigned int primID2 = prim.primID(N)[i2];
-              geom->prefetchL2_vertices(geom->curve(primID2));
+              prim.prefetchL2_vertices(geom,i2,N);
             }
           }
 
@@ -364,7 +370,12 @@ namespace embree
       }
       
       template<typename Intersector, typename Epilog>
-        static __forceinline bool occluded_t(Precalculations& pre, RayK<K>& ray, const size_t k, IntersectContext* context, const Primitive& prim)
+        static __forceinline void intersect_t(Precalculations& pre, RayHitK<K>& ray, const size_t k, IntersectContext* context, const Primitive& prim) {
+        intersect_leaf_t<Intersector,Epilog>(pre,ray,k,context,prim);
+      }
+
+      template<typename Intersector, typename Epilog, typename Prim>
+        static __forceinline bool occluded_leaf_t(Precalculations& pre, RayK<K>& ray, const size_t k, IntersectContext* context, const Prim& prim)
       {
         vfloat<M> tNear;
         vbool<M> valid = intersect(ray,k,prim,tNear);
@@ -378,17 +389,15 @@ namespace embree
           const unsigned int geomID = prim.geomID(N);
           const unsigned int primID = prim.primID(N)[i];
           const CurveGeometry* geom = context->scene->get<CurveGeometry>(geomID);
-          Vec3ff a0,a1,a2,a3; geom->gather(a0,a1,a2,a3,geom->curve(primID));
+          Vec3ff a0,a1,a2,a3; prim.gather(a0,a1,a2,a3,geom,i,N);
 
           size_t mask1 = mask;
           const size_t i1 = bscf(mask1);
           if (mask) {
-            const unsigned int primID1 = prim.primID(N)[i1];
-            geom->prefetchL1_vertices(geom->curve(primID1));
+            prim.prefetchL1_vertices(geom,i1,N);
             if (mask1) {
               const size_t i2 = bsf(mask1);
-              const unsigned int primID2 = prim.primID(N)[i2];
-              geom->prefetchL2_vertices(geom->curve(primID2));
+              prim.prefetchL2_vertices(geom,i2,N);
             }
           }
           
@@ -400,6 +409,11 @@ namespace embree
         return false;
       }
 
+      template<typename Intersector, typename Epilog>
+        static __forceinline bool occluded_t(Precalculations& pre, RayK<K>& ray, const size_t k, IntersectContext* context, const Primitive& prim) {
+        return occluded_leaf_t<Intersector,Epilog>(pre,ray,k,context,prim);
+      }
+
       template<typename Intersector, typename Epilog>
         static __forceinline void intersect_n(Precalculations& pre, RayHitK<K>& ray, const size_t k, IntersectContext* context, const Primitive& prim)
       {
@@ -0,0 +1,178 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "curveNi.h"
+
+namespace embree
+{
+  /* Curve leaf that additionally stores the control points of each
+   * curve quantized to 16 bits relative to the bounds of all control
+   * points of the leaf. Radii are quantized relative to the maximal
+   * radius of the leaf. A full leaf of 4 curves requires about 70
+   * bytes per curve compared to about 95 bytes for CurveNv, and avoids
+   * the indirect vertex fetches of CurveNi. */
+  template<int M>
+    struct CurveNq : public CurveNi<M>
+  {
+    using CurveNi<M>::N;
+
+    struct Type : public PrimitiveType {
+      const char* name() const;
+      size_t sizeActive(const char* This) const;
+      size_t sizeTotal(const char* This) const;
+      size_t getBytes(const char* This) const;
+    };
+    static Type type;
+
+  public:
+
+    /* Returns maximum number of stored primitives */
+    static __forceinline size_t max_size() { return M; }
+
+    /* Returns required number of primitive blocks for N primitives */
+    static __forceinline size_t blocks(size_t N) { return (N+M-1)/M; }
+
+    static __forceinline size_t bytes(size_t N)
+    {
+      const size_t f = N/M, r = N%M;
+      static_assert(sizeof(CurveNq) == 22+25*M+28+32*M, "internal data layout issue");
+      return f*sizeof(CurveNq) + (r!=0)*(22 + 25*r + 28 + 32*r);
+    }
+
+  public:
+
+    /*! Default constructor. */
+    __forceinline CurveNq () {}
+
+    /*! fill curve from curve list */
+    __forceinline void fill(const PrimRef* prims, size_t& begin, size_t _end, Scene* scene)
+    {
+      size_t end = min(begin+M,_end);
+      size_t N = end-begin;
+
+      /* calculate quantization bounds of all control points */
+      BBox3fa bounds = empty;
+      float maxRadius = 0.0f;
+      for (size_t i=0; i<N; i++)
+      {
+        const PrimRef& prim = prims[begin+i];
+        CurveGeometry* mesh = (CurveGeometry*) scene->get(prim.geomID());
+        const unsigned vtxID = mesh->curve(prim.primID());
+        for (size_t j=0; j<4; j++) {
+          const Vec3ff v = mesh->vertex(vtxID+j);
+          bounds.extend(Vec3fa(v));
+          maxRadius = max(maxRadius,v.w);
+        }
+      }
+
+      const Vec3fa size = bounds.size();
+      const Vec3fa iscale(size.x > 0.0f ? 65535.0f/size.x : 0.0f,
+                          size.y > 0.0f ? 65535.0f/size.y : 0.0f,
+                          size.z > 0.0f ? 65535.0f/size.z : 0.0f);
+      const float irscale = maxRadius > 0.0f ? 65535.0f/maxRadius : 0.0f;
+      *qoffset(N) = Vec3f(bounds.lower.x,bounds.lower.y,bounds.lower.z);
+      *qscale(N) = Vec3f(size.x/65535.0f,size.y/65535.0f,size.z/65535.0f);
+      *rscale(N) = maxRadius/65535.0f;
+
+      /* encode all control points */
+      for (size_t i=0; i<N; i++)
+      {
+        const PrimRef& prim = prims[begin+i];
+        CurveGeometry* mesh = (CurveGeometry*) scene->get(prim.geomID());
+        const unsigned vtxID = mesh->curve(prim.primID());
+        for (size_t j=0; j<4; j++)
+        {
+          const Vec3ff v = mesh->vertex(vtxID+j);
+          const Vec3fa p = (Vec3fa(v)-bounds.lower)*iscale;
+          unsigned short* q = vertices(i,N)+4*j;
+          q[0] = (unsigned short) clamp(floor(p.x+0.5f),0.0f,65535.0f);
+          q[1] = (unsigned short) clamp(floor(p.y+0.5f),0.0f,65535.0f);
+          q[2] = (unsigned short) clamp(floor(p.z+0.5f),0.0f,65535.0f);
+          q[3] = (unsigned short) clamp(floor(v.w*irscale+0.5f),0.0f,65535.0f);
+        }
+      }
+    }
+
+    /*! decodes the control points of the i'th curve */
+    __forceinline void gather(Vec3ff& p0, Vec3ff& p1, Vec3ff& p2, Vec3ff& p3, const CurveGeometry* geom, size_t i, size_t N) const
+    {
+      const Vec3f& o = *qoffset(N);
+      const Vec3f& s = *qscale(N);
+      const Vec3fa ofs(o.x,o.y,o.z);
+      const Vec3fa scale(s.x,s.y,s.z);
+      const float rs = *rscale(N);
+      const unsigned short* q = vertices(i,N);
+      p0 = Vec3ff(ofs + Vec3fa(float(q[ 0]),float(q[ 1]),float(q[ 2]))*scale, float(q[ 3])*rs);
+      p1 = Vec3ff(ofs + Vec3fa(float(q[ 4]),float(q[ 5]),float(q[ 6]))*scale, float(q[ 7])*rs);
+      p2 = Vec3ff(ofs + Vec3fa(float(q[ 8]),float(q[ 9]),float(q[10]))*scale, float(q[11])*rs);
+      p3 = Vec3ff(ofs + Vec3fa(float(q[12]),float(q[13]),float(q[14]))*scale, float(q[15])*rs);
+    }
+
+    /*! prefetches the quantized control points of the i'th curve */
+    __forceinline void prefetchL1_vertices(const CurveGeometry* geom, size_t i, size_t N) const {
+      prefetchL1(vertices(i,N));
+    }
+
+    __forceinline void prefetchL2_vertices(const CurveGeometry* geom, size_t i, size_t N) const {
+      prefetchL2(vertices(i,N));
+    }
+
+    template<typename BVH, typename Allocator>
+      __forceinline static typename BVH::NodeRef createLeaf (BVH* bvh, const PrimRef* prims, const range<size_t>& set, const Allocator& alloc)
+    {
+      if (set.size() == 0)
+        return BVH::emptyNode;
+
+      /* fall back to CurveNi for oriented and hermite curves */
+      unsigned int geomID = prims[set.begin()].geomID();
+      if (bvh->scene->get(geomID)->getCurveType() == Geometry::GTY_SUBTYPE_ORIENTED_CURVE) {
+        return CurveNi<M>::createLeaf(bvh,prims,set,alloc);
+      }
+      if (bvh->scene->get(geomID)->getCurveBasis() == Geometry::GTY_BASIS_HERMITE) {
+        return CurveNi<M>::createLeaf(bvh,prims,set,alloc);
+      }
+
+      size_t start = set.begin();
+      size_t items = CurveNq::blocks(set.size());
+      size_t numbytes = CurveNq::bytes(set.size());
+      CurveNq* accel = (CurveNq*) alloc.malloc1(numbytes,BVH::byteAlignment);
+      for (size_t i=0; i<items; i++) {
+        accel[i].CurveNq<M>::fill(prims,start,set.end(),bvh->scene);
+        accel[i].CurveNi<M>::fill(prims,start,set.end(),bvh->scene);
+      }
+      return bvh->encodeLeaf((char*)accel,items);
+    };
+
+  public:
+
+    /*
+    struct Layout
+    {
+      Vec3f qoffset;
+      Vec3f qscale;
+      float rscale;
+      unsigned short vertices[N][4][4];
+    };
+    */
+    unsigned char data[28+32*M];
+
+    __forceinline       Vec3f* qoffset(size_t N)       { return (Vec3f*)(CurveNi<M>::end(N)); }
+    __forceinline const Vec3f* qoffset(size_t N) const { return (Vec3f*)(CurveNi<M>::end(N)); }
+
+    __forceinline       Vec3f* qscale(size_t N)       { return (Vec3f*)(CurveNi<M>::end(N)+12); }
+    __forceinline const Vec3f* qscale(size_t N) const { return (Vec3f*)(CurveNi<M>::end(N)+12); }
+
+    __forceinline       float* rscale(size_t N)       { return (float*)(CurveNi<M>::end(N)+24); }
+    __forceinline const float* rscale(size_t N) const { return (float*)(CurveNi<M>::end(N)+24); }
+
+    __forceinline       unsigned short* vertices(size_t i, size_t N)       { return (unsigned short*)(CurveNi<M>::end(N)+28)+16*i; }
+    __forceinline const unsigned short* vertices(size_t i, size_t N) const { return (unsigned short*)(CurveNi<M>::end(N)+28)+16*i; }
+  };
+
+  template<int M>
+    typename CurveNq<M>::Type CurveNq<M>::type;
+
+  typedef CurveNq<4> Curve4q;
+}
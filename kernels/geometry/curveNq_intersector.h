@@ -0,0 +1,47 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "curveNq.h"
+#include "curveNi_intersector.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    template<int M>
+      struct CurveNqIntersector1 : public CurveNiIntersector1<M>
+    {
+      typedef CurveNq<M> Primitive;
+      typedef CurvePrecalculations1 Precalculations;
+
+      template<typename Intersector, typename Epilog>
+        static __forceinline void intersect_t(const Precalculations& pre, RayHit& ray, IntersectContext* context, const Primitive& prim) {
+        CurveNiIntersector1<M>::template intersect_leaf_t<Intersector,Epilog>(pre,ray,context,prim);
+      }
+
+      template<typename Intersector, typename Epilog>
+        static __forceinline bool occluded_t(const Precalculations& pre, Ray& ray, IntersectContext* context, const Primitive& prim) {
+        return CurveNiIntersector1<M>::template occluded_leaf_t<Intersector,Epilog>(pre,ray,context,prim);
+      }
+    };
+
+    template<int M, int K>
+      struct CurveNqIntersectorK : public CurveNiIntersectorK<M,K>
+    {
+      typedef CurveNq<M> Primitive;
+      typedef CurvePrecalculationsK<K> Precalculations;
+
+      template<typename Intersector, typename Epilog>
+        static __forceinline void intersect_t(Precalculations& pre, RayHitK<K>& ray, const size_t k, IntersectContext* context, const Primitive& prim) {
+        CurveNiIntersectorK<M,K>::template intersect_leaf_t<Intersector,Epilog>(pre,ray,k,context,prim);
+      }
+
+      template<typename Intersector, typename Epilog>
+        static __forceinline bool occluded_t(Precalculations& pre, RayK<K>& ray, const size_t k, IntersectContext* context, const Primitive& prim) {
+        return CurveNiIntersectorK<M,K>::template occluded_leaf_t<Intersector,Epilog>(pre,ray,k,context,prim);
+      }
+    };
+  }
+}
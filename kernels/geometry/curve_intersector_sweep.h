@@ -20,6 +20,46 @@ namespace embree
     static const size_t numBezierSubdivisions = 3;
 #endif
 
+    /*! Subdivision depth and Jacobian iteration count used to intersect
+     *  a curve. Curves that are small compared to the ray footprint get
+     *  intersected with fewer subdivisions and iterations and a relaxed
+     *  convergence tolerance. */
+    struct CurveFootprint
+    {
+      __forceinline CurveFootprint()
+        : maxDepth(numBezierSubdivisions), maxIterations(numJacobianIterations), tolerance(0.0f) {}
+
+      template<typename NativeCurve3ff>
+      __forceinline CurveFootprint(const IntersectContext* context, const Vec3fa& ray_org, const NativeCurve3ff& curve)
+        : maxDepth(numBezierSubdivisions), maxIterations(numJacobianIterations), tolerance(0.0f)
+      {
+        const float factor = context->scene->footprintDistanceFactor;
+        if (likely(factor <= 0.0f)) return;
+
+        /* compare extent of curve with footprint of ray at the curve */
+        const BBox3ff box = curve.bounds();
+        const Vec3fa lower(box.lower), upper(box.upper);
+        const float extent = length(upper-lower) + 2.0f*box.upper.w;
+        const float footprint = factor*length(0.5f*(lower+upper)-ray_org);
+
+        if (extent <= footprint) {
+          maxDepth = 1;
+          maxIterations = 3;
+          tolerance = 0.1f*footprint;
+        }
+        else if (extent <= 4.0f*footprint) {
+          maxDepth = max(numBezierSubdivisions,size_t(2))-1;
+          maxIterations = 4;
+          tolerance = 0.05f*footprint;
+        }
+      }
+
+    public:
+      unsigned int maxDepth;        //!< maximal subdivision depth of curve
+      unsigned int maxIterations;   //!< maximal number of Jacobian iterations
+      float tolerance;              //!< additional tolerance in world space to accept a converged hit
+    };
+
     struct BezierCurveHit
     {
       __forceinline BezierCurveHit() {}
@@ -54,7 +94,7 @@ namespace embree
     }
 
     template<typename NativeCurve3ff, typename Ray, typename Epilog> 
-     __forceinline bool intersect_bezier_iterative_jacobian(const Ray& ray, const float dt, const NativeCurve3ff& curve, float u, float t, const Epilog& epilog)
+     __forceinline bool intersect_bezier_iterative_jacobian(const Ray& ray, const float dt, const NativeCurve3ff& curve, float u, float t, const CurveFootprint& footprint, const Epilog& epilog)
     {
       const Vec3fa org = zero;
       const Vec3fa dir = ray.dir;
@@ -64,7 +104,7 @@ namespace embree
       const BBox3ff box = curve.bounds();
       const float P_err = 16.0f*float(ulp)*reduce_max(max(abs(box.lower),abs(box.upper)));
      
-      for (size_t i=0; i<numJacobianIterations; i++) 
+      for (size_t i=0; i<footprint.maxIterations; i++) 
       {
         const Vec3fa Q = madd(Vec3fa(t),dir,org);
         //const Vec3fa dQdu = zero;
@@ -117,7 +157,7 @@ namespace embree
         const Vec2f ut = Vec2f(u,t) - dut;
         u = ut.x; t = ut.y;
 
-        if (abs(f) < f_err && abs(g) < g_err)
+        if (abs(f) < max(f_err,footprint.tolerance) && abs(g) < max(g_err,footprint.tolerance))
         {
           t+=dt;
           if (!(ray.tnear() <= t && t <= ray.tfar)) return false; // rejects NaNs
@@ -134,7 +174,7 @@ namespace embree
 
     template<typename NativeCurve3ff, typename Ray, typename Epilog>
     bool intersect_bezier_recursive_jacobian(const Ray& ray, const float dt, const NativeCurve3ff& curve,
-                                             float u0, float u1, unsigned int depth, const Epilog& epilog)
+                                             float u0, float u1, unsigned int depth, const CurveFootprint& footprint, const Epilog& epilog)
     {
 #if defined(__AVX__)
       enum { VSIZEX_ = 8 };
@@ -150,7 +190,7 @@ namespace embree
       typedef Vec3<vfloatx> Vec3vfx;
       typedef Vec4<vfloatx> Vec4vfx;
     
-      unsigned int maxDepth = numBezierSubdivisions;
+      unsigned int maxDepth = footprint.maxDepth;
       bool found = false;
       const Vec3fa org = zero;
       const Vec3fa dir = ray.dir;
@@ -263,7 +303,7 @@ namespace embree
         while (any(valid0))
         {
           const size_t i = select_min(valid0,tp0.lower); clear(valid0,i);
-          found = found | intersect_bezier_iterative_jacobian(ray,dt,curve,u_outer0[i],tp0.lower[i],epilog);
+          found = found | intersect_bezier_iterative_jacobian(ray,dt,curve,u_outer0[i],tp0.lower[i],footprint,epilog);
           //found = found | intersect_bezier_iterative_debug   (ray,dt,curve,i,u_outer0,tp0,h0,h1,Ng_outer0,dP0du,dP3du,epilog);
           valid0 &= tp0.lower+dt <= ray.tfar;
         }
@@ -277,7 +317,7 @@ namespace embree
         while (any(valid1))
         {
           const size_t i = select_min(valid1,tp1.lower); clear(valid1,i);
-          found = found | intersect_bezier_iterative_jacobian(ray,dt,curve,u_outer1[i],tp1.upper[i],epilog);
+          found = found | intersect_bezier_iterative_jacobian(ray,dt,curve,u_outer1[i],tp1.upper[i],footprint,epilog);
           //found = found | intersect_bezier_iterative_debug   (ray,dt,curve,i,u_outer1,tp1,h0,h1,Ng_outer1,dP0du,dP3du,epilog);
           valid1 &= tp1.lower+dt <= ray.tfar;
         }
@@ -325,7 +365,8 @@ namespace embree
         const float dt = dot(curve0.center()-ray.org,ray.dir)*rcp(dot(ray.dir,ray.dir));
         const Vec3ff ref(madd(Vec3fa(dt),ray.dir,ray.org),0.0f);
         const NativeCurve3ff curve1 = curve0-ref;
-        return intersect_bezier_recursive_jacobian(ray,dt,curve1,0.0f,1.0f,1,epilog);
+        const CurveFootprint footprint(context,ray.org,curve0);
+        return intersect_bezier_recursive_jacobian(ray,dt,curve1,0.0f,1.0f,1,footprint,epilog);
       }
     };
 
@@ -367,7 +408,8 @@ namespace embree
         const float dt = dot(curve0.center()-ray.org,ray.dir)*rcp(dot(ray.dir,ray.dir));
         const Vec3ff ref(madd(Vec3fa(dt),ray.dir,ray.org),0.0f);
         const NativeCurve3ff curve1 = curve0-ref;
-        return intersect_bezier_recursive_jacobian(ray,dt,curve1,0.0f,1.0f,1,epilog);
+        const CurveFootprint footprint(context,ray.org,curve0);
+        return intersect_bezier_recursive_jacobian(ray,dt,curve1,0.0f,1.0f,1,footprint,epilog);
       }
     };
   }
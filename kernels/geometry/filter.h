@@ -7,16 +7,25 @@
 #include "../common/ray.h"
 #include "../common/hit.h"
 #include "../common/context.h"
+#include "../common/scene.h"
 
 namespace embree
 {
   namespace isa
   {
+    /* records a filter function invocation in the scene statistics */
+    __forceinline void countFilterCall(IntersectContext* context)
+    {
+      if (unlikely(context->scene->hasStatistics()))
+        context->scene->statistics.addFilterCall();
+    }
+
     __forceinline bool runIntersectionFilter1Helper(RTCFilterFunctionNArguments* args, const Geometry* const geometry, IntersectContext* context)
     {
       if (geometry->intersectionFilterN)
       {
         assert(context->scene->hasGeometryFilterFunction());
+        countFilterCall(context);
         geometry->intersectionFilterN(args);
 
         if (args->valid[0] == 0)
@@ -25,6 +34,7 @@ namespace embree
             
       if (context->user->filter) {
         assert(context->scene->hasContextFilterFunction());
+        countFilterCall(context);
         context->user->filter(args);
 
         if (args->valid[0] == 0)
@@ -64,6 +74,7 @@ namespace embree
       if (geometry->occlusionFilterN)
       {
         assert(context->scene->hasGeometryFilterFunction());
+        countFilterCall(context);
         geometry->occlusionFilterN(args);
 
         if (args->valid[0] == 0)
@@ -72,6 +83,7 @@ namespace embree
       
       if (context->user->filter) {
         assert(context->scene->hasContextFilterFunction());
+        countFilterCall(context);
         context->user->filter(args);
 
         if (args->valid[0] == 0)
@@ -111,6 +123,7 @@ namespace embree
       if (geometry->intersectionFilterN)
       {
         assert(context->scene->hasGeometryFilterFunction());
+        countFilterCall(context);
         geometry->intersectionFilterN(args);
       }
 
@@ -119,6 +132,7 @@ namespace embree
 
       if (context->user->filter) {
         assert(context->scene->hasContextFilterFunction());
+        countFilterCall(context);
         context->user->filter(args);
       }
 
@@ -150,6 +164,7 @@ namespace embree
       if (geometry->occlusionFilterN)
       {
         assert(context->scene->hasGeometryFilterFunction());
+        countFilterCall(context);
         geometry->occlusionFilterN(args);
       }
 
@@ -159,6 +174,7 @@ namespace embree
 
       if (context->user->filter) {
         assert(context->scene->hasContextFilterFunction());
+        countFilterCall(context);
         context->user->filter(args);
       }
 
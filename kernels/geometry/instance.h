@@ -35,7 +35,40 @@ namespace embree
     InstancePrimitive (const Instance* instance, unsigned int instID) 
     : instance(instance) 
     , instID_(instID)
-    {}
+    {
+      setWorld2Local(instance);
+    }
+
+    /* Returns the world to local transformation stored in the leaf,
+     * which is only valid for instances without motion blur */
+    __forceinline AffineSpace3fa getWorld2Local() const
+    {
+      return AffineSpace3fa(Vec3fa::loadu(&world2local[0]),Vec3fa::loadu(&world2local[4]),
+                            Vec3fa::loadu(&world2local[8]),Vec3fa::loadu(&world2local[12]));
+    }
+
+    /* Returns the instanced acceleration structure */
+    __forceinline Accel* getObject() const { return object; }
+
+    /* Returns the mask of the instance */
+    __forceinline unsigned int getMask() const { return mask; }
+
+  private:
+
+    /* Copies the data required to traverse the instance into the leaf,
+     * such that traversal does not need to access the instance */
+    __forceinline void setWorld2Local(const Instance* instance)
+    {
+      const AffineSpace3fa xfm = instance->getWorld2Local();
+      world2local[ 0] = xfm.l.vx.x; world2local[ 1] = xfm.l.vx.y; world2local[ 2] = xfm.l.vx.z; world2local[ 3] = 0.0f;
+      world2local[ 4] = xfm.l.vy.x; world2local[ 5] = xfm.l.vy.y; world2local[ 6] = xfm.l.vy.z; world2local[ 7] = 0.0f;
+      world2local[ 8] = xfm.l.vz.x; world2local[ 9] = xfm.l.vz.y; world2local[10] = xfm.l.vz.z; world2local[11] = 0.0f;
+      world2local[12] = xfm.p.x;    world2local[13] = xfm.p.y;    world2local[14] = xfm.p.z;    world2local[15] = 0.0f;
+      object = instance->object;
+      mask = object ? instance->mask & object->mask : instance->mask;
+    }
+
+  public:
 
     __forceinline void fill(const PrimRef* prims, size_t& i, size_t end, Scene* scene)
     {
@@ -68,9 +101,15 @@ namespace embree
 
     /* Updates the primitive */
     __forceinline BBox3fa update(Instance* instance) {
+      setWorld2Local(instance);
       return instance->bounds(0);
     }
 
+  private:
+    float world2local[16];  //!< world to local transformation of the instance, stored column wise with each column padded to 4 floats
+    Accel* object;          //!< instanced acceleration structure
+    unsigned int mask;      //!< mask of the instance, restricted to the masks of the instanced geometries
+
   public:
     const Instance* instance;
     const unsigned int instID_ = std::numeric_limits<unsigned int>::max ();
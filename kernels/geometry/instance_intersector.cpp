@@ -10,6 +10,14 @@ namespace embree
   namespace isa
   {
 
+    /* Returns the instanced scene, a lazily committed scene gets built on its first visit. */
+    __forceinline Scene* visitScene(Accel* object)
+    {
+      Scene* scene = (Scene*)object;
+      scene->visitLazy();
+      return scene;
+    }
+
     /* Push an instance to the stack. */
     RTC_FORCEINLINE bool pushInstance(RTCPointQueryContext* context,
                       unsigned int instanceId,
@@ -46,24 +54,24 @@ namespace embree
 
     void InstanceIntersector1::intersect(const Precalculations& pre, RayHit& ray, IntersectContext* context, const InstancePrimitive& prim)
     {
-      const Instance* instance = prim.instance;
+      Accel* object = prim.getObject();
 
       /* perform ray mask test */
 #if defined(EMBREE_RAY_MASK)
-      if ((ray.mask & instance->mask) == 0) 
+      if ((ray.mask & prim.getMask()) == 0) 
         return;
 #endif
 
       RTCIntersectContext* user_context = context->user;
       if (likely(instance_id_stack::push(user_context, prim.instID_)))
       {
-        const AffineSpace3fa world2local = instance->getWorld2Local();
+        const AffineSpace3fa world2local = prim.getWorld2Local();
         const Vec3ff ray_org = ray.org;
         const Vec3ff ray_dir = ray.dir;
         ray.org = Vec3ff(xfmPoint(world2local, ray_org), ray.tnear());
         ray.dir = Vec3ff(xfmVector(world2local, ray_dir), ray.time());
-        IntersectContext newcontext((Scene*)instance->object, user_context);
-        instance->object->intersectors.intersect((RTCRayHit&)ray, &newcontext);
+        IntersectContext newcontext(visitScene(object), user_context);
+        object->intersectors.intersect((RTCRayHit&)ray, &newcontext);
         ray.org = ray_org;
         ray.dir = ray_dir;
         instance_id_stack::pop(user_context);
@@ -72,11 +80,11 @@ namespace embree
     
     bool InstanceIntersector1::occluded(const Precalculations& pre, Ray& ray, IntersectContext* context, const InstancePrimitive& prim)
     {
-      const Instance* instance = prim.instance;
+      Accel* object = prim.getObject();
       
       /* perform ray mask test */
 #if defined(EMBREE_RAY_MASK)
-      if ((ray.mask & instance->mask) == 0) 
+      if ((ray.mask & prim.getMask()) == 0) 
         return false;
 #endif
       
@@ -84,13 +92,13 @@ namespace embree
       bool occluded = false;
       if (likely(instance_id_stack::push(user_context, prim.instID_)))
       {
-        const AffineSpace3fa world2local = instance->getWorld2Local();
+        const AffineSpace3fa world2local = prim.getWorld2Local();
         const Vec3ff ray_org = ray.org;
         const Vec3ff ray_dir = ray.dir;
         ray.org = Vec3ff(xfmPoint(world2local, ray_org), ray.tnear());
         ray.dir = Vec3ff(xfmVector(world2local, ray_dir), ray.time());
-        IntersectContext newcontext((Scene*)instance->object, user_context);
-        instance->object->intersectors.occluded((RTCRay&)ray, &newcontext);
+        IntersectContext newcontext(visitScene(object), user_context);
+        object->intersectors.occluded((RTCRay&)ray, &newcontext);
         ray.org = ray_org;
         ray.dir = ray_dir;
         occluded = ray.tfar < 0.0f;
@@ -118,7 +126,7 @@ namespace embree
         query_inst.radius = query->radius * similarityScale;
         
         PointQueryContext context_inst(
-          (Scene*)instance->object, 
+          visitScene(instance->object), 
           context->query_ws, 
           similtude ? POINT_QUERY_TYPE_SPHERE : POINT_QUERY_TYPE_AABB,
           context->func, 
@@ -133,6 +141,47 @@ namespace embree
       return false;
     }
 
+    bool InstanceIntersector1::pointQuery(PointQuery* query, PointQueryContext* context, const Instance* instance, unsigned int instID,
+                                          const unsigned int* geomIDs, const unsigned int* primIDs, size_t num)
+    {
+      const AffineSpace3fa local2world = instance->getLocal2World();
+      const AffineSpace3fa world2local = instance->getWorld2Local();
+      float similarityScale = 0.f;
+      const bool similtude = context->query_type == POINT_QUERY_TYPE_SPHERE
+                           && similarityTransform(world2local, &similarityScale);
+      assert((similtude && similarityScale > 0) || !similtude);
+
+      if (likely(pushInstance(context->userContext, instID, world2local, local2world)))
+      {
+        PointQuery query_inst;
+        query_inst.time = query->time;
+        query_inst.p = xfmPoint(world2local, query->p);
+        query_inst.radius = query->radius * similarityScale;
+
+        Scene* object = (Scene*)instance->object;
+        PointQueryContext context_inst(
+          object,
+          context->query_ws,
+          similtude ? POINT_QUERY_TYPE_SPHERE : POINT_QUERY_TYPE_AABB,
+          context->func,
+          context->userContext,
+          similarityScale,
+          context->userPtr);
+
+        bool changed = false;
+        for (size_t i=0; i<num; i++)
+        {
+          STAT3(point_query.trav_prims,1,1,1);
+          context_inst.geomID = geomIDs[i];
+          context_inst.primID = primIDs[i];
+          changed |= object->get(geomIDs[i])->pointQuery(&query_inst, &context_inst);
+        }
+        popInstance(context->userContext);
+        return changed;
+      }
+      return false;
+    }
+
     void InstanceIntersector1MB::intersect(const Precalculations& pre, RayHit& ray, IntersectContext* context, const InstancePrimitive& prim)
     {
       const Instance* instance = prim.instance;
@@ -151,7 +200,7 @@ namespace embree
         const Vec3ff ray_dir = ray.dir;
         ray.org = Vec3ff(xfmPoint(world2local, ray_org), ray.tnear());
         ray.dir = Vec3ff(xfmVector(world2local, ray_dir), ray.time());
-        IntersectContext newcontext((Scene*)instance->object, user_context);
+        IntersectContext newcontext(visitScene(instance->object), user_context);
         instance->object->intersectors.intersect((RTCRayHit&)ray, &newcontext);
         ray.org = ray_org;
         ray.dir = ray_dir;
@@ -178,7 +227,7 @@ namespace embree
         const Vec3ff ray_dir = ray.dir;
         ray.org = Vec3ff(xfmPoint(world2local, ray_org), ray.tnear());
         ray.dir = Vec3ff(xfmVector(world2local, ray_dir), ray.time());
-        IntersectContext newcontext((Scene*)instance->object, user_context);
+        IntersectContext newcontext(visitScene(instance->object), user_context);
         instance->object->intersectors.occluded((RTCRay&)ray, &newcontext);
         ray.org = ray_org;
         ray.dir = ray_dir;
@@ -206,7 +255,7 @@ namespace embree
         query_inst.radius = query->radius * similarityScale;
         
         PointQueryContext context_inst(
-          (Scene*)instance->object, 
+          visitScene(instance->object), 
           context->query_ws, 
           similtude ? POINT_QUERY_TYPE_SPHERE : POINT_QUERY_TYPE_AABB,
           context->func, 
@@ -221,31 +270,193 @@ namespace embree
       return false;
     }
     
+    /* Returns the world to local transformation of a static instance,
+     * which is stored in the leaf of the instance. */
+    struct World2LocalStatic
+    {
+      __forceinline World2LocalStatic (const InstancePrimitive& prim)
+        : world2local(prim.getWorld2Local()) {}
+
+      __forceinline AffineSpace3fa operator() (float time) const {
+        return world2local;
+      }
+
+      template<int K>
+      __forceinline AffineSpace3vf<K> get (const vbool<K>& valid, const vfloat<K>& time) const {
+        return AffineSpace3vf<K>(world2local);
+      }
+
+      const AffineSpace3fa world2local;
+    };
+
+    /* Returns the world to local transformation of a motion blurred instance. */
+    struct World2LocalMB
+    {
+      __forceinline World2LocalMB (const Instance* instance)
+        : instance(instance) {}
+
+      __forceinline AffineSpace3fa operator() (float time) const {
+        return instance->getWorld2Local(time);
+      }
+
+      template<int K>
+      __forceinline AffineSpace3vf<K> get (const vbool<K>& valid, const vfloat<K>& time) const {
+        return instance->getWorld2Local<K>(valid, time);
+      }
+
+      const Instance* instance;
+    };
+
+    __forceinline void intersectInstance1(Accel* object, RayHit& ray, IntersectContext* context) {
+      object->intersectors.intersect((RTCRayHit&)ray, context);
+    }
+
+    __forceinline void intersectInstance1(Accel* object, Ray& ray, IntersectContext* context) {
+      object->intersectors.occluded((RTCRay&)ray, context);
+    }
+
+    /* copies the hit of a single ray into the k'th ray of a packet */
+    template<int K>
+    __forceinline void copyHit(RayHitK<K>& dst, size_t k, const RayHit& src)
+    {
+      dst.tfar[k] = src.tfar;
+      dst.Ng.x[k] = src.Ng.x; dst.Ng.y[k] = src.Ng.y; dst.Ng.z[k] = src.Ng.z;
+      dst.u[k] = src.u; dst.v[k] = src.v;
+      dst.primID[k] = src.primID; dst.geomID[k] = src.geomID;
+      instance_id_stack::copy_UV<K>(src.instID, dst.instID, k);
+    }
+
+    template<int K>
+    __forceinline void copyHit(RayK<K>& dst, size_t k, const Ray& src) {
+      dst.tfar[k] = src.tfar;
+    }
+
+    /* Intersects each active ray of a packet separately with the
+     * instanced scene, used if only very few rays hit the instance. */
+    template<int K, typename RayTy, typename World2Local>
+    __forceinline void intersectInstanceSingle(const vbool<K>& valid, RayTy& ray, const World2Local& getWorld2Local, IntersectContext* context)
+    {
+      for (size_t m=movemask(valid), k=bscf(m); ; k=bscf(m))
+      {
+        typename std::conditional<std::is_same<RayTy,RayHitK<K>>::value,RayHit,Ray>::type ray1;
+        ray.get(k, ray1);
+        const AffineSpace3fa world2local = getWorld2Local(ray1.time());
+        ray1.org = Vec3ff(xfmPoint(world2local, Vec3fa(ray1.org)), ray1.tnear());
+        ray1.dir = Vec3ff(xfmVector(world2local, Vec3fa(ray1.dir)), ray1.time());
+        intersectInstance1(context->scene, ray1, context);
+        copyHit(ray, k, ray1);
+        if (m == 0) break;
+      }
+    }
+
+    /* Gathers the active rays of a packet into a dense packet of
+     * smaller width Kc, such that the instanced scene gets traversed
+     * with a packet of good SIMD utilization. */
+    template<int K, int Kc, typename RayTy, typename RayTyC, typename World2Local>
+    __forceinline void intersectInstanceCompact(const vbool<K>& valid, RayTy& ray, RayTyC& rayc, const World2Local& getWorld2Local, IntersectContext* context)
+    {
+      typename std::conditional<std::is_same<RayTy,RayHitK<K>>::value,RayHit,Ray>::type ray1;
+      size_t index[Kc];
+      size_t n = 0;
+      for (size_t m=movemask(valid); m!=0; n++) {
+        index[n] = bscf(m);
+        ray.get(index[n], ray1);
+        rayc.set(n, ray1);
+      }
+      for (size_t i=n; i<Kc; i++)
+        rayc.copy(i, 0);
+
+      const vbool<Kc> validc = vint<Kc>(step) < vint<Kc>(int(n));
+      const AffineSpace3vf<Kc> world2local = getWorld2Local.template get<Kc>(validc, rayc.time());
+      rayc.org = xfmPoint(world2local, rayc.org);
+      rayc.dir = xfmVector(world2local, rayc.dir);
+      context->scene->intersectors.intersect(validc, rayc, context);
+
+      for (size_t i=0; i<n; i++) {
+        rayc.get(i, ray1);
+        copyHit(ray, index[i], ray1);
+      }
+    }
+
+    /* Transforms the full packet into instance space. */
+    template<int K, typename RayTy, typename World2Local>
+    __forceinline void intersectInstancePacket(const vbool<K>& valid, RayTy& ray, const World2Local& getWorld2Local, IntersectContext* context)
+    {
+      const AffineSpace3vf<K> world2local = getWorld2Local.template get<K>(valid, ray.time());
+      const Vec3vf<K> ray_org = ray.org;
+      const Vec3vf<K> ray_dir = ray.dir;
+      ray.org = xfmPoint(world2local, ray_org);
+      ray.dir = xfmVector(world2local, ray_dir);
+      context->scene->intersectors.intersect(valid, ray, context);
+      ray.org = ray_org;
+      ray.dir = ray_dir;
+    }
+
+    /* Intersects the active rays of a packet with the instanced scene
+     * of the context. Packets where only few rays hit the instance get
+     * compacted into a narrower packet or traced as single rays. */
+    template<typename RayTy, typename World2Local>
+    __forceinline void intersectInstanceK(const vbool4& valid, RayTy& ray, const World2Local& getWorld2Local, IntersectContext* context)
+    {
+      if (popcnt(valid) == 1)
+        intersectInstanceSingle<4>(valid, ray, getWorld2Local, context);
+      else
+        intersectInstancePacket<4>(valid, ray, getWorld2Local, context);
+    }
+
+#if defined(__AVX__)
+    template<typename RayTy, typename World2Local>
+    __forceinline void intersectInstanceK(const vbool8& valid, RayTy& ray, const World2Local& getWorld2Local, IntersectContext* context)
+    {
+      const size_t numActive = popcnt(valid);
+      if (numActive == 1)
+        intersectInstanceSingle<8>(valid, ray, getWorld2Local, context);
+      else if (numActive <= 4) {
+        typename std::conditional<std::is_same<RayTy,RayHitK<8>>::value,RayHitK<4>,RayK<4>>::type rayc;
+        intersectInstanceCompact<8,4>(valid, ray, rayc, getWorld2Local, context);
+      }
+      else
+        intersectInstancePacket<8>(valid, ray, getWorld2Local, context);
+    }
+#endif
+
+#if defined(__AVX512F__)
+    template<typename RayTy, typename World2Local>
+    __forceinline void intersectInstanceK(const vbool16& valid, RayTy& ray, const World2Local& getWorld2Local, IntersectContext* context)
+    {
+      const size_t numActive = popcnt(valid);
+      if (numActive == 1)
+        intersectInstanceSingle<16>(valid, ray, getWorld2Local, context);
+      else if (numActive <= 4) {
+        typename std::conditional<std::is_same<RayTy,RayHitK<16>>::value,RayHitK<4>,RayK<4>>::type rayc;
+        intersectInstanceCompact<16,4>(valid, ray, rayc, getWorld2Local, context);
+      }
+      else if (numActive <= 8) {
+        typename std::conditional<std::is_same<RayTy,RayHitK<16>>::value,RayHitK<8>,RayK<8>>::type rayc;
+        intersectInstanceCompact<16,8>(valid, ray, rayc, getWorld2Local, context);
+      }
+      else
+        intersectInstancePacket<16>(valid, ray, getWorld2Local, context);
+    }
+#endif
+
     template<int K>
     void InstanceIntersectorK<K>::intersect(const vbool<K>& valid_i, const Precalculations& pre, RayHitK<K>& ray, IntersectContext* context, const InstancePrimitive& prim)
     {
       vbool<K> valid = valid_i;
-      const Instance* instance = prim.instance;
-      //ray.geomID = 10;
+      Accel* object = prim.getObject();
       
       /* perform ray mask test */
 #if defined(EMBREE_RAY_MASK)
-      valid &= (ray.mask & instance->mask) != 0;
+      valid &= (ray.mask & prim.getMask()) != 0;
       if (none(valid)) return;
 #endif
         
       RTCIntersectContext* user_context = context->user;
       if (likely(instance_id_stack::push(user_context, prim.instID_)))
       {
-        AffineSpace3vf<K> world2local = instance->getWorld2Local();
-        const Vec3vf<K> ray_org = ray.org;
-        const Vec3vf<K> ray_dir = ray.dir;
-        ray.org = xfmPoint(world2local, ray_org);
-        ray.dir = xfmVector(world2local, ray_dir);
-        IntersectContext newcontext((Scene*)instance->object, user_context);
-        instance->object->intersectors.intersect(valid, ray, &newcontext);
-        ray.org = ray_org;
-        ray.dir = ray_dir;
+        IntersectContext newcontext(visitScene(object), user_context);
+        intersectInstanceK(valid, ray, World2LocalStatic(prim), &newcontext);
         instance_id_stack::pop(user_context);
       }
     }
@@ -254,11 +465,11 @@ namespace embree
     vbool<K> InstanceIntersectorK<K>::occluded(const vbool<K>& valid_i, const Precalculations& pre, RayK<K>& ray, IntersectContext* context, const InstancePrimitive& prim)
     {
       vbool<K> valid = valid_i;
-      const Instance* instance = prim.instance;
+      Accel* object = prim.getObject();
       
       /* perform ray mask test */
 #if defined(EMBREE_RAY_MASK)
-      valid &= (ray.mask & instance->mask) != 0;
+      valid &= (ray.mask & prim.getMask()) != 0;
       if (none(valid)) return false;
 #endif
         
@@ -266,15 +477,8 @@ namespace embree
       vbool<K> occluded = false;
       if (likely(instance_id_stack::push(user_context, prim.instID_)))
       {
-        AffineSpace3vf<K> world2local = instance->getWorld2Local();
-        const Vec3vf<K> ray_org = ray.org;
-        const Vec3vf<K> ray_dir = ray.dir;
-        ray.org = xfmPoint(world2local, ray_org);
-        ray.dir = xfmVector(world2local, ray_dir);
-        IntersectContext newcontext((Scene*)instance->object, user_context);
-        instance->object->intersectors.occluded(valid, ray, &newcontext);
-        ray.org = ray_org;
-        ray.dir = ray_dir;
+        IntersectContext newcontext(visitScene(object), user_context);
+        intersectInstanceK(valid, ray, World2LocalStatic(prim), &newcontext);
         occluded = ray.tfar < 0.0f;
         instance_id_stack::pop(user_context);
       }
@@ -296,15 +500,8 @@ namespace embree
       RTCIntersectContext* user_context = context->user;
       if (likely(instance_id_stack::push(user_context, prim.instID_)))
       {
-        AffineSpace3vf<K> world2local = instance->getWorld2Local<K>(valid, ray.time());
-        const Vec3vf<K> ray_org = ray.org;
-        const Vec3vf<K> ray_dir = ray.dir;
-        ray.org = xfmPoint(world2local, ray_org);
-        ray.dir = xfmVector(world2local, ray_dir);
-        IntersectContext newcontext((Scene*)instance->object, user_context);
-        instance->object->intersectors.intersect(valid, ray, &newcontext);
-        ray.org = ray_org;
-        ray.dir = ray_dir;
+        IntersectContext newcontext(visitScene(instance->object), user_context);
+        intersectInstanceK(valid, ray, World2LocalMB(instance), &newcontext);
         instance_id_stack::pop(user_context);
       }
     }
@@ -325,15 +522,8 @@ namespace embree
       vbool<K> occluded = false;
       if (likely(instance_id_stack::push(user_context, prim.instID_)))
       {
-        AffineSpace3vf<K> world2local = instance->getWorld2Local<K>(valid, ray.time());
-        const Vec3vf<K> ray_org = ray.org;
-        const Vec3vf<K> ray_dir = ray.dir;
-        ray.org = xfmPoint(world2local, ray_org);
-        ray.dir = xfmVector(world2local, ray_dir);
-        IntersectContext newcontext((Scene*)instance->object, user_context);
-        instance->object->intersectors.occluded(valid, ray, &newcontext);
-        ray.org = ray_org;
-        ray.dir = ray_dir;
+        IntersectContext newcontext(visitScene(instance->object), user_context);
+        intersectInstanceK(valid, ray, World2LocalMB(instance), &newcontext);
         occluded = ray.tfar < 0.0f;
         instance_id_stack::pop(user_context);
       }
@@ -22,6 +22,10 @@ namespace embree
       static void intersect(const Precalculations& pre, RayHit& ray, IntersectContext* context, const Primitive& prim);
       static bool occluded(const Precalculations& pre, Ray& ray, IntersectContext* context, const Primitive& prim);
       static bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& prim);
+
+      /*! performs the point query for num primitives of the instanced scene, used for flattened instances */
+      static bool pointQuery(PointQuery* query, PointQueryContext* context, const Instance* instance, unsigned int instID,
+                             const unsigned int* geomIDs, const unsigned int* primIDs, size_t num);
     };
 
     struct InstanceIntersector1MB
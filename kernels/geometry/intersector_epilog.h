@@ -63,7 +63,7 @@ namespace embree
         ray.v = hit.v;
         ray.primID = primID;
         ray.geomID = geomID;
-        instance_id_stack::copy_UU(context->user->instID, ray.instID);
+        instance_id_stack::copy_UU(context->user, ray.instID);
         return true;
       }
     };
@@ -162,7 +162,7 @@ namespace embree
         ray.v[k] = hit.v;
         ray.primID[k] = primID;
         ray.geomID[k] = geomID;
-        instance_id_stack::copy_UV<K>(context->user->instID, ray.instID, k);
+        instance_id_stack::copy_UV<K>(context->user, ray.instID, k);
         return true;
       }
     };
@@ -286,7 +286,7 @@ namespace embree
         ray.v = uv.y;
         ray.primID = primIDs[i];
         ray.geomID = geomID;
-        instance_id_stack::copy_UU(context->user->instID, ray.instID);
+        instance_id_stack::copy_UU(context->user, ray.instID);
         return true;
 
       }
@@ -423,7 +423,7 @@ namespace embree
         ray.v = uv.y;
         ray.primID = primID;
         ray.geomID = geomID;
-        instance_id_stack::copy_UU(context->user->instID, ray.instID);
+        instance_id_stack::copy_UU(context->user, ray.instID);
         return true;
       }
     };
@@ -533,7 +533,7 @@ namespace embree
         vfloat<K>::store(valid,&ray.v,v);
         vuint<K>::store(valid,&ray.primID,primID);
         vuint<K>::store(valid,&ray.geomID,geomID);
-        instance_id_stack::copy_UV<K>(context->user->instID, ray.instID, valid);
+        instance_id_stack::copy_UV<K>(context->user, ray.instID, valid);
         return valid;
       }
     };
@@ -648,7 +648,7 @@ namespace embree
         vfloat<K>::store(valid,&ray.v,v);
         vuint<K>::store(valid,&ray.primID,primID);
         vuint<K>::store(valid,&ray.geomID,geomID);
-        instance_id_stack::copy_UV<K>(context->user->instID, ray.instID, valid);
+        instance_id_stack::copy_UV<K>(context->user, ray.instID, valid);
         return valid;
       }
     };
@@ -782,7 +782,7 @@ namespace embree
         ray.v[k] = uv.y;
         ray.primID[k] = primIDs[i];
         ray.geomID[k] = geomID;
-        instance_id_stack::copy_UV<K>(context->user->instID, ray.instID, k);
+        instance_id_stack::copy_UV<K>(context->user, ray.instID, k);
         return true;
       }
     };
@@ -922,7 +922,7 @@ namespace embree
         ray.v[k] = uv.y;
         ray.primID[k] = primID;
         ray.geomID[k] = geomID;
-        instance_id_stack::copy_UV<K>(context->user->instID, ray.instID, k);
+        instance_id_stack::copy_UV<K>(context->user, ray.instID, k);
         return true;
       }
     };
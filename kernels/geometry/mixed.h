@@ -0,0 +1,35 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "primitive.h"
+
+namespace embree
+{
+  /* Leaves of a BVH over primitives of different types. Each leaf is
+   * encoded using NodeRef::encodeTypedLeaf and stores the type of its
+   * single primitive block instead of the number of blocks. */
+  struct MixedPrimitive
+  {
+    /*! types of leaves */
+    enum LeafType
+    {
+      TY_TRIANGLE4 = 1,  //!< Triangle4 block
+      TY_QUAD4V    = 2,  //!< Quad4v block
+      TY_CURVE     = 3,  //!< curve, line, or point block dispatched through the virtual curve intersector
+      TY_OBJECT    = 4,  //!< user geometry Object
+      TY_INSTANCE  = 5   //!< InstancePrimitive
+    };
+
+    struct Type : public PrimitiveType
+    {
+      const char* name() const;
+      size_t sizeActive(const char* This) const;
+      size_t sizeTotal(const char* This) const;
+      size_t getBytes(const char* This) const;
+      const PrimitiveType* leafType(const char* This, size_t& num) const;
+    };
+    static Type type;
+  };
+}
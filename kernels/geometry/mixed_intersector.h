@@ -0,0 +1,156 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "mixed.h"
+#include "triangle_intersector.h"
+#include "quadv_intersector.h"
+#include "object_intersector.h"
+#include "instance_intersector.h"
+#include "curve_intersector_virtual.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! Intersects a ray with a typed leaf of a mixed BVH by
+     *  dispatching to the intersector of the leaf type. */
+    struct MixedIntersector1
+    {
+      typedef char Primitive;
+
+      typedef TriangleMIntersector1Moeller<4,true> TriangleIntersector;
+      typedef QuadMvIntersector1Moeller<4,true> QuadIntersector;
+      typedef ObjectIntersector1<false> ObjectIntersector;
+      typedef InstanceIntersector1 InstanceIntersector;
+
+      struct Precalculations
+      {
+        __forceinline Precalculations (const Ray& ray, const void* ptr)
+          : tri(ray,ptr), quad(ray,ptr), curve(ray,ptr), object(ray,ptr), instance(ray,ptr) {}
+
+        TriangleIntersector::Precalculations tri;
+        QuadIntersector::Precalculations quad;
+        CurvePrecalculations1 curve;
+        ObjectIntersector::Precalculations object;
+        InstanceIntersector::Precalculations instance;
+      };
+
+      template<int N, bool robust>
+      static __forceinline void intersect(const Accel::Intersectors* This, Precalculations& pre, RayHit& ray, IntersectContext* context, const Primitive* prim, size_t ty, const TravRay<N,robust> &tray, size_t& lazy_node)
+      {
+        switch (ty) {
+        case MixedPrimitive::TY_TRIANGLE4: TriangleIntersector::intersect(pre.tri,ray,context,*(const Triangle4*)prim); break;
+        case MixedPrimitive::TY_QUAD4V   : QuadIntersector::intersect(pre.quad,ray,context,*(const Quad4v*)prim); break;
+        case MixedPrimitive::TY_CURVE    : VirtualCurveIntersector1::intersect(This,pre.curve,ray,context,(const unsigned char*)prim,1,tray,lazy_node); break;
+        case MixedPrimitive::TY_OBJECT   : ObjectIntersector::intersect(pre.object,ray,context,*(const Object*)prim); break;
+        case MixedPrimitive::TY_INSTANCE : InstanceIntersector::intersect(pre.instance,ray,context,*(const InstancePrimitive*)prim); break;
+        default: assert(false);
+        }
+      }
+
+      template<int N, bool robust>
+      static __forceinline bool occluded(const Accel::Intersectors* This, Precalculations& pre, Ray& ray, IntersectContext* context, const Primitive* prim, size_t ty, const TravRay<N,robust> &tray, size_t& lazy_node)
+      {
+        switch (ty) {
+        case MixedPrimitive::TY_TRIANGLE4: return TriangleIntersector::occluded(pre.tri,ray,context,*(const Triangle4*)prim);
+        case MixedPrimitive::TY_QUAD4V   : return QuadIntersector::occluded(pre.quad,ray,context,*(const Quad4v*)prim);
+        case MixedPrimitive::TY_CURVE    : return VirtualCurveIntersector1::occluded(This,pre.curve,ray,context,(const unsigned char*)prim,1,tray,lazy_node);
+        case MixedPrimitive::TY_OBJECT   : return ObjectIntersector::occluded(pre.object,ray,context,*(const Object*)prim);
+        case MixedPrimitive::TY_INSTANCE : return InstanceIntersector::occluded(pre.instance,ray,context,*(const InstancePrimitive*)prim);
+        default: assert(false); return false;
+        }
+      }
+
+      template<int N>
+      static __forceinline bool pointQuery(const Accel::Intersectors* This, PointQuery* query, PointQueryContext* context, const Primitive* prim, size_t ty, const TravPointQuery<N> &tquery, size_t& lazy_node)
+      {
+        switch (ty) {
+        case MixedPrimitive::TY_TRIANGLE4: return TriangleIntersector::pointQuery(query,context,*(const Triangle4*)prim);
+        case MixedPrimitive::TY_QUAD4V   : return QuadIntersector::pointQuery(query,context,*(const Quad4v*)prim);
+        case MixedPrimitive::TY_OBJECT   : return ObjectIntersector::pointQuery(query,context,*(const Object*)prim);
+        case MixedPrimitive::TY_INSTANCE : return InstanceIntersector::pointQuery(query,context,*(const InstancePrimitive*)prim);
+        default: return false; // point queries are not supported for curves
+        }
+      }
+    };
+
+    /*! Intersects a ray packet with a typed leaf of a mixed BVH by
+     *  dispatching to the intersector of the leaf type. */
+    template<int K>
+    struct MixedIntersectorK
+    {
+      typedef char Primitive;
+
+      typedef TriangleMIntersectorKMoeller<4,K,true> TriangleIntersector;
+      typedef QuadMvIntersectorKMoeller<4,K,true> QuadIntersector;
+      typedef ObjectIntersectorK<K,false> ObjectIntersector;
+      typedef InstanceIntersectorK<K> InstanceIntersector;
+
+      struct Precalculations
+      {
+        __forceinline Precalculations (const vbool<K>& valid, const RayK<K>& ray)
+          : tri(valid,ray), quad(valid,ray), curve(valid,ray), object(valid,ray), instance(valid,ray) {}
+
+        typename TriangleIntersector::Precalculations tri;
+        typename QuadIntersector::Precalculations quad;
+        CurvePrecalculationsK<K> curve;
+        typename ObjectIntersector::Precalculations object;
+        typename InstanceIntersector::Precalculations instance;
+      };
+
+      template<bool robust>
+      static __forceinline void intersect(const vbool<K>& valid, const Accel::Intersectors* This, Precalculations& pre, RayHitK<K>& ray, IntersectContext* context, const Primitive* prim, size_t ty, const TravRayK<K, robust> &tray, size_t& lazy_node)
+      {
+        switch (ty) {
+        case MixedPrimitive::TY_TRIANGLE4: TriangleIntersector::intersect(valid,pre.tri,ray,context,*(const Triangle4*)prim); break;
+        case MixedPrimitive::TY_QUAD4V   : QuadIntersector::intersect(valid,pre.quad,ray,context,*(const Quad4v*)prim); break;
+        case MixedPrimitive::TY_CURVE    : VirtualCurveIntersectorK<K>::intersect(valid,This,pre.curve,ray,context,(const unsigned char*)prim,1,tray,lazy_node); break;
+        case MixedPrimitive::TY_OBJECT   : ObjectIntersector::intersect(valid,pre.object,ray,context,*(const Object*)prim); break;
+        case MixedPrimitive::TY_INSTANCE : InstanceIntersector::intersect(valid,pre.instance,ray,context,*(const InstancePrimitive*)prim); break;
+        default: assert(false);
+        }
+      }
+
+      template<bool robust>
+      static __forceinline vbool<K> occluded(const vbool<K>& valid, const Accel::Intersectors* This, Precalculations& pre, RayK<K>& ray, IntersectContext* context, const Primitive* prim, size_t ty, const TravRayK<K, robust> &tray, size_t& lazy_node)
+      {
+        switch (ty) {
+        case MixedPrimitive::TY_TRIANGLE4: return TriangleIntersector::occluded(valid,pre.tri,ray,context,*(const Triangle4*)prim);
+        case MixedPrimitive::TY_QUAD4V   : return QuadIntersector::occluded(valid,pre.quad,ray,context,*(const Quad4v*)prim);
+        case MixedPrimitive::TY_CURVE    : return VirtualCurveIntersectorK<K>::occluded(valid,This,pre.curve,ray,context,(const unsigned char*)prim,1,tray,lazy_node);
+        case MixedPrimitive::TY_OBJECT   : return ObjectIntersector::occluded(valid,pre.object,ray,context,*(const Object*)prim);
+        case MixedPrimitive::TY_INSTANCE : return InstanceIntersector::occluded(valid,pre.instance,ray,context,*(const InstancePrimitive*)prim);
+        default: assert(false); return false;
+        }
+      }
+
+      template<int N, bool robust>
+      static __forceinline void intersect(const Accel::Intersectors* This, Precalculations& pre, RayHitK<K>& ray, size_t k, IntersectContext* context, const Primitive* prim, size_t ty, const TravRay<N,robust> &tray, size_t& lazy_node)
+      {
+        switch (ty) {
+        case MixedPrimitive::TY_TRIANGLE4: TriangleIntersector::intersect(pre.tri,ray,k,context,*(const Triangle4*)prim); break;
+        case MixedPrimitive::TY_QUAD4V   : QuadIntersector::intersect(pre.quad,ray,k,context,*(const Quad4v*)prim); break;
+        case MixedPrimitive::TY_CURVE    : VirtualCurveIntersectorK<K>::intersect(This,pre.curve,ray,k,context,(const unsigned char*)prim,1,tray,lazy_node); break;
+        case MixedPrimitive::TY_OBJECT   : ObjectIntersector::intersect(pre.object,ray,k,context,*(const Object*)prim); break;
+        case MixedPrimitive::TY_INSTANCE : InstanceIntersector::intersect(pre.instance,ray,k,context,*(const InstancePrimitive*)prim); break;
+        default: assert(false);
+        }
+      }
+
+      template<int N, bool robust>
+      static __forceinline bool occluded(const Accel::Intersectors* This, Precalculations& pre, RayK<K>& ray, size_t k, IntersectContext* context, const Primitive* prim, size_t ty, const TravRay<N,robust> &tray, size_t& lazy_node)
+      {
+        switch (ty) {
+        case MixedPrimitive::TY_TRIANGLE4: return TriangleIntersector::occluded(pre.tri,ray,k,context,*(const Triangle4*)prim);
+        case MixedPrimitive::TY_QUAD4V   : return QuadIntersector::occluded(pre.quad,ray,k,context,*(const Quad4v*)prim);
+        case MixedPrimitive::TY_CURVE    : return VirtualCurveIntersectorK<K>::occluded(This,pre.curve,ray,k,context,(const unsigned char*)prim,1,tray,lazy_node);
+        case MixedPrimitive::TY_OBJECT   : return ObjectIntersector::occluded(pre.object,ray,k,context,*(const Object*)prim);
+        case MixedPrimitive::TY_INSTANCE : return InstanceIntersector::occluded(pre.instance,ray,k,context,*(const InstancePrimitive*)prim);
+        default: assert(false); return false;
+        }
+      }
+    };
+  }
+}
@@ -24,6 +24,9 @@ namespace embree
 
     /*! Returns the number of bytes of block. */
     virtual size_t getBytes(const char* This) const = 0;
+
+    /*! Returns the type of the primitive blocks of the leaf starting at This and updates num to the number of blocks, typed leaves store a leaf type in num. */
+    virtual const PrimitiveType* leafType(const char* This, size_t& num) const { return this; }
   };
   
   template<typename Primitive>
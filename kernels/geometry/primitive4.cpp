@@ -3,19 +3,23 @@
 
 #include "primitive.h"
 #include "curveNv.h"
+#include "curveNq.h"
 #include "curveNi.h"
 #include "curveNi_mb.h"
 #include "linei.h"
+#include "pointi.h"
 #include "triangle.h"
 #include "trianglev.h"
 #include "trianglev_mb.h"
 #include "trianglei.h"
+#include "trianglef.h"
 #include "quadv.h"
 #include "quadi.h"
 #include "subdivpatch1.h"
 #include "object.h"
 #include "instance.h"
 #include "subgrid.h"
+#include "mixed.h"
 
 namespace embree
 {
@@ -53,6 +57,43 @@ namespace embree
         return Curve4v::bytes(sizeActive(This));
   }
 
+  /********************** Curve4q **************************/
+
+  template<>
+  const char* Curve4q::Type::name () const {
+    return "curve4q";
+  }
+
+  template<>
+  size_t Curve4q::Type::sizeActive(const char* This) const
+  {
+    if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+      return ((Line4i*)This)->size();
+    else
+      return ((Curve4q*)This)->N;
+  }
+
+  template<>
+  size_t Curve4q::Type::sizeTotal(const char* This) const
+  {
+    if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+      return 4;
+    else
+      return ((Curve4q*)This)->N;
+  }
+
+  template<>
+  size_t Curve4q::Type::getBytes(const char* This) const
+  {
+    if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+      return Line4i::bytes(sizeActive(This));
+    else if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_HERMITE ||
+             (*This & Geometry::GType::GTY_SUBTYPE_MASK) == Geometry::GType::GTY_SUBTYPE_ORIENTED_CURVE)
+      return Curve4i::bytes(sizeActive(This));
+    else
+      return Curve4q::bytes(sizeActive(This));
+  }
+
   /********************** Curve4i **************************/
 
   template<>
@@ -143,6 +184,28 @@ namespace embree
     return sizeof(Line4i);
   }
 
+  /********************** Point4i **************************/
+
+  template<>
+  const char* Point4i::Type::name () const {
+    return "point4i";
+  }
+
+  template<>
+  size_t Point4i::Type::sizeActive(const char* This) const {
+    return ((Point4i*)This)->size();
+  }
+
+  template<>
+  size_t Point4i::Type::sizeTotal(const char* This) const {
+    return 4;
+  }
+
+  template<>
+  size_t Point4i::Type::getBytes(const char* This) const {
+    return sizeof(Point4i);
+  }
+
   /********************** Triangle4 **************************/
 
   template<>
@@ -209,6 +272,28 @@ namespace embree
     return sizeof(Triangle4i);
   }
 
+  /********************** Triangle4f **************************/
+
+  template<>
+  const char* Triangle4f::Type::name () const {
+    return "triangle4f";
+  }
+
+  template<>
+  size_t Triangle4f::Type::sizeActive(const char* This) const {
+    return ((Triangle4f*)This)->size();
+  }
+
+  template<>
+  size_t Triangle4f::Type::sizeTotal(const char* This) const {
+    return 4;
+  }
+
+  template<>
+  size_t Triangle4f::Type::getBytes(const char* This) const {
+    return sizeof(Triangle4f);
+  }
+
   /********************** Triangle4vMB **************************/
 
   template<>
@@ -335,6 +420,48 @@ namespace embree
 
   InstancePrimitive::Type InstancePrimitive::type;
 
+  /********************** Mixed **************************/
+
+  const char* MixedPrimitive::Type::name () const {
+    return "mixed";
+  }
+
+  size_t MixedPrimitive::Type::sizeActive(const char* This) const {
+    return 0;
+  }
+
+  size_t MixedPrimitive::Type::sizeTotal(const char* This) const {
+    return 0;
+  }
+
+  size_t MixedPrimitive::Type::getBytes(const char* This) const {
+    return 0;
+  }
+
+  const PrimitiveType* MixedPrimitive::Type::leafType(const char* This, size_t& num) const
+  {
+    const size_t ty = num; num = 1;
+    switch (ty) {
+    case TY_TRIANGLE4: return &Triangle4::type;
+    case TY_QUAD4V   : return &Quad4v::type;
+    case TY_CURVE    :
+    {
+      /* curve, line, and point blocks all start with the geometry type */
+      const Geometry::GType gtype = (Geometry::GType) *(const unsigned char*)This;
+      if (gtype >= Geometry::GTY_SPHERE_POINT && gtype <= Geometry::GTY_ORIENTED_DISC_POINT) return &Point4i::type;
+      if ((gtype & Geometry::GTY_BASIS_MASK) == Geometry::GTY_BASIS_LINEAR) return &Line4i::type;
+      if ((gtype & Geometry::GTY_SUBTYPE_MASK) == Geometry::GTY_SUBTYPE_ORIENTED_CURVE) return &Curve4i::type;
+      if ((gtype & Geometry::GTY_BASIS_MASK) == Geometry::GTY_BASIS_HERMITE) return &Curve4i::type;
+      return &Curve4v::type;
+    }
+    case TY_OBJECT   : return &Object::type;
+    case TY_INSTANCE : return &InstancePrimitive::type;
+    default          : num = 0; return this;
+    }
+  }
+
+  MixedPrimitive::Type MixedPrimitive::type;
+
   /********************** SubGrid **************************/
 
   const char* SubGrid::Type::name () const {
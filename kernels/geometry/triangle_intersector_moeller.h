@@ -369,7 +369,7 @@ namespace embree
                                             const UVMapper& mapUV,
                                             const Epilog& epilog) const
       {
-        MoellerTrumboreHitK<K,UVIdentity<K>> hit(mapUV);			
+        MoellerTrumboreHitK<K,UVMapper> hit(mapUV);
         const Vec3vf<K> tri_Ng = cross(tri_e2,tri_e1);
         const vbool<K> valid = intersectK(valid0,ray.org,ray.dir,ray.tnear(),ray.tfar,tri_v0,tri_e1,tri_e2,tri_Ng,mapUV,hit);
 	return epilog(valid,hit);
@@ -0,0 +1,120 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "triangle.h"
+#include "../common/scene_instance.h"
+
+namespace embree
+{
+  /* Stores M triangles of a flattened instance. The triangles are
+   * transformed into the space of the instancing scene, such that rays
+   * can get intersected without transforming them into instance
+   * space. All triangles of a block belong to the same instance. */
+  template <int M>
+  struct TriangleMf : public TriangleM<M>
+  {
+    using TriangleM<M>::geomID;
+    using TriangleM<M>::primID;
+
+    struct Type : public PrimitiveType
+    {
+      const char* name() const;
+      size_t sizeActive(const char* This) const;
+      size_t sizeTotal(const char* This) const;
+      size_t getBytes(const char* This) const;
+    };
+    static Type type;
+
+  public:
+
+    /* Returns maximum number of stored triangles */
+    static __forceinline size_t max_size() { return M; }
+
+    /* Returns required number of primitive blocks for N primitives */
+    static __forceinline size_t blocks(size_t N) { return (N+M-1)/M; }
+
+    /* Maps the index of a triangle of the instanced scene to its geometry and primitive ID */
+    static __forceinline bool decode(const Scene* object, unsigned int index, unsigned int& geomID, unsigned int& primID)
+    {
+      for (size_t i=0; i<object->size(); i++)
+      {
+        const Geometry* geom = object->get(i);
+        if (geom == nullptr || !geom->isEnabled() || geom->getType() != Geometry::GTY_TRIANGLE_MESH)
+          continue;
+        if (index < geom->size()) {
+          geomID = unsigned(i); primID = index;
+          return true;
+        }
+        index -= unsigned(geom->size());
+      }
+      return false;
+    }
+
+  public:
+
+    /* Returns the instance the triangles belong to */
+    __forceinline const Instance* getInstance() const { return instance; }
+
+    /* Returns the geometry ID of the instance */
+    __forceinline unsigned int instID() const { return instID_; }
+
+    /* Returns the transformation of geometry normals into instance space */
+    __forceinline LinearSpace3fa getNormalSpace() const {
+      return LinearSpace3fa(Vec3fa(Ns[0].x,Ns[0].y,Ns[0].z),Vec3fa(Ns[1].x,Ns[1].y,Ns[1].z),Vec3fa(Ns[2].x,Ns[2].y,Ns[2].z));
+    }
+
+    /* Fill block from triangles of a single instance, the primitive
+     * ID of each primref indexes the triangles of the instanced scene */
+    __forceinline void fill(const PrimRef* prims, size_t& begin, size_t end, Scene* scene)
+    {
+      const unsigned int instID = prims[begin].geomID();
+      const Instance* inst = scene->get<Instance>(instID);
+      const Scene* object = (const Scene*) inst->object;
+      const AffineSpace3fa local2world = inst->getLocal2World();
+
+      vuint<M> vgeomID = -1, vprimID = -1;
+      Vec3vf<M> v0 = zero, v1 = zero, v2 = zero;
+
+      for (size_t i=0; i<M && begin<end && prims[begin].geomID() == instID; i++, begin++)
+      {
+        unsigned int geomID = 0, primID = 0;
+        const bool found MAYBE_UNUSED = decode(object,prims[begin].primID(),geomID,primID);
+        assert(found);
+        const TriangleMesh* __restrict__ const mesh = object->get<TriangleMesh>(geomID);
+        const TriangleMesh::Triangle& tri = mesh->triangle(primID);
+        const Vec3fa p0 = xfmPoint(local2world,mesh->vertex(tri.v[0]));
+        const Vec3fa p1 = xfmPoint(local2world,mesh->vertex(tri.v[1]));
+        const Vec3fa p2 = xfmPoint(local2world,mesh->vertex(tri.v[2]));
+        vgeomID [i] = geomID;
+        vprimID [i] = primID;
+        v0.x[i] = p0.x; v0.y[i] = p0.y; v0.z[i] = p0.z;
+        v1.x[i] = p1.x; v1.y[i] = p1.y; v1.z[i] = p1.z;
+        v2.x[i] = p2.x; v2.y[i] = p2.y; v2.z[i] = p2.z;
+      }
+      TriangleM<M>::store_nt(this,TriangleM<M>(v0,v1,v2,vgeomID,vprimID));
+
+      /* the cross product of transformed edges equals det(L)*L^-T times
+       * the cross product of the original edges, thus L^T/det(L) maps
+       * geometry normals back into instance space */
+      const LinearSpace3fa l = local2world.l;
+      const LinearSpace3fa N = l.transposed()/l.det();
+      Ns[0] = Vec3f(N.vx.x,N.vx.y,N.vx.z);
+      Ns[1] = Vec3f(N.vy.x,N.vy.y,N.vy.z);
+      Ns[2] = Vec3f(N.vz.x,N.vz.y,N.vz.z);
+      instance = inst;
+      instID_ = instID;
+    }
+
+  private:
+    const Instance* instance; //!< flattened instance
+    unsigned int instID_;     //!< geometry ID of the flattened instance
+    Vec3f Ns[3];              //!< columns of the transformation of geometry normals into instance space
+  };
+
+  template<int M>
+  typename TriangleMf<M>::Type TriangleMf<M>::type;
+
+  typedef TriangleMf<4> Triangle4f;
+}
@@ -0,0 +1,190 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "trianglef.h"
+#include "triangle_intersector_moeller.h"
+#include "instance_intersector.h"
+#include "../common/instance_stack.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! Transforms the geometry normal of a hit into instance space */
+    template<int M>
+    struct NormalSpaceMapper
+    {
+      __forceinline NormalSpaceMapper(const LinearSpace3fa& space)
+        : space(space) {}
+
+      __forceinline void operator() (vfloat<M>& u, vfloat<M>& v, Vec3vf<M>& Ng) const
+      {
+        const Vec3vf<M> N = Ng;
+        Ng.x = madd(vfloat<M>(space.vx.x),N.x,madd(vfloat<M>(space.vy.x),N.y,vfloat<M>(space.vz.x)*N.z));
+        Ng.y = madd(vfloat<M>(space.vx.y),N.x,madd(vfloat<M>(space.vy.y),N.y,vfloat<M>(space.vz.y)*N.z));
+        Ng.z = madd(vfloat<M>(space.vx.z),N.x,madd(vfloat<M>(space.vy.z),N.y,vfloat<M>(space.vz.z)*N.z));
+      }
+
+      const LinearSpace3fa space;
+    };
+
+    /*! Intersects M triangles of a flattened instance with 1 ray. The
+     *  instance gets pushed to the instance ID stack and hits are
+     *  reported in the space of the instanced scene as for regular
+     *  instances. */
+    template<int M, bool filter>
+    struct TriangleMfIntersector1Moeller
+    {
+      typedef TriangleMf<M> Primitive;
+      typedef MoellerTrumboreIntersector1<M> Precalculations;
+
+      static __forceinline void intersect(const Precalculations& pre, RayHit& ray, IntersectContext* context, const Primitive& tri)
+      {
+        STAT3(normal.trav_prims,1,1,1);
+        const Instance* instance = tri.getInstance();
+#if defined(EMBREE_RAY_MASK)
+        if ((ray.mask & instance->mask) == 0)
+          return;
+#endif
+        RTCIntersectContext* user_context = context->user;
+        if (likely(instance_id_stack::push(user_context,tri.instID())))
+        {
+          IntersectContext newcontext((Scene*)instance->object,user_context);
+          pre.intersectEdge(ray,tri.v0,tri.e1,tri.e2,NormalSpaceMapper<M>(tri.getNormalSpace()),Intersect1EpilogM<M,filter>(ray,&newcontext,tri.geomID(),tri.primID()));
+          instance_id_stack::pop(user_context);
+        }
+      }
+
+      static __forceinline bool occluded(const Precalculations& pre, Ray& ray, IntersectContext* context, const Primitive& tri)
+      {
+        STAT3(shadow.trav_prims,1,1,1);
+        const Instance* instance = tri.getInstance();
+#if defined(EMBREE_RAY_MASK)
+        if ((ray.mask & instance->mask) == 0)
+          return false;
+#endif
+        RTCIntersectContext* user_context = context->user;
+        bool occluded = false;
+        if (likely(instance_id_stack::push(user_context,tri.instID())))
+        {
+          IntersectContext newcontext((Scene*)instance->object,user_context);
+          occluded = pre.intersectEdge(ray,tri.v0,tri.e1,tri.e2,NormalSpaceMapper<M>(tri.getNormalSpace()),Occluded1EpilogM<M,filter>(ray,&newcontext,tri.geomID(),tri.primID()));
+          instance_id_stack::pop(user_context);
+        }
+        return occluded;
+      }
+
+      static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& tri)
+      {
+        unsigned int geomIDs[M], primIDs[M];
+        size_t num = 0;
+        for (; num<M && tri.valid(num); num++) {
+          geomIDs[num] = tri.geomID(num);
+          primIDs[num] = tri.primID(num);
+        }
+        return InstanceIntersector1::pointQuery(query,context,tri.getInstance(),tri.instID(),geomIDs,primIDs,num);
+      }
+    };
+
+    /*! Intersects M triangles of a flattened instance with K rays. */
+    template<int M, int K, bool filter>
+    struct TriangleMfIntersectorKMoeller
+    {
+      typedef TriangleMf<M> Primitive;
+      typedef MoellerTrumboreIntersectorK<M,K> Precalculations;
+
+      static __forceinline void intersect(const vbool<K>& valid_i, Precalculations& pre, RayHitK<K>& ray, IntersectContext* context, const Primitive& tri)
+      {
+        const Instance* instance = tri.getInstance();
+        vbool<K> valid = valid_i;
+#if defined(EMBREE_RAY_MASK)
+        valid &= (ray.mask & instance->mask) != 0;
+        if (none(valid)) return;
+#endif
+        RTCIntersectContext* user_context = context->user;
+        if (likely(instance_id_stack::push(user_context,tri.instID())))
+        {
+          IntersectContext newcontext((Scene*)instance->object,user_context);
+          const NormalSpaceMapper<K> mapUV(tri.getNormalSpace());
+          for (size_t i=0; i<Primitive::max_size(); i++)
+          {
+            if (!tri.valid(i)) break;
+            STAT3(normal.trav_prims,1,popcnt(valid),K);
+            const Vec3vf<K> p0 = broadcast<vfloat<K>>(tri.v0,i);
+            const Vec3vf<K> e1 = broadcast<vfloat<K>>(tri.e1,i);
+            const Vec3vf<K> e2 = broadcast<vfloat<K>>(tri.e2,i);
+            pre.intersectEdgeK(valid,ray,p0,e1,e2,mapUV,IntersectKEpilogM<M,K,filter>(ray,&newcontext,tri.geomID(),tri.primID(),i));
+          }
+          instance_id_stack::pop(user_context);
+        }
+      }
+
+      static __forceinline vbool<K> occluded(const vbool<K>& valid_i, Precalculations& pre, RayK<K>& ray, IntersectContext* context, const Primitive& tri)
+      {
+        const Instance* instance = tri.getInstance();
+        vbool<K> valid0 = valid_i;
+#if defined(EMBREE_RAY_MASK)
+        valid0 &= (ray.mask & instance->mask) != 0;
+        if (none(valid0)) return !valid_i;
+#endif
+        const vbool<K> active = valid0;
+        RTCIntersectContext* user_context = context->user;
+        if (likely(instance_id_stack::push(user_context,tri.instID())))
+        {
+          IntersectContext newcontext((Scene*)instance->object,user_context);
+          const NormalSpaceMapper<K> mapUV(tri.getNormalSpace());
+          for (size_t i=0; i<Primitive::max_size(); i++)
+          {
+            if (!tri.valid(i)) break;
+            STAT3(shadow.trav_prims,1,popcnt(valid0),K);
+            const Vec3vf<K> p0 = broadcast<vfloat<K>>(tri.v0,i);
+            const Vec3vf<K> e1 = broadcast<vfloat<K>>(tri.e1,i);
+            const Vec3vf<K> e2 = broadcast<vfloat<K>>(tri.e2,i);
+            pre.intersectEdgeK(valid0,ray,p0,e1,e2,mapUV,OccludedKEpilogM<M,K,filter>(valid0,ray,&newcontext,tri.geomID(),tri.primID(),i));
+            if (none(valid0)) break;
+          }
+          instance_id_stack::pop(user_context);
+        }
+        return !valid_i | (active & !valid0);
+      }
+
+      static __forceinline void intersect(Precalculations& pre, RayHitK<K>& ray, size_t k, IntersectContext* context, const Primitive& tri)
+      {
+        STAT3(normal.trav_prims,1,1,1);
+        const Instance* instance = tri.getInstance();
+#if defined(EMBREE_RAY_MASK)
+        if ((ray.mask[k] & instance->mask) == 0)
+          return;
+#endif
+        RTCIntersectContext* user_context = context->user;
+        if (likely(instance_id_stack::push(user_context,tri.instID())))
+        {
+          IntersectContext newcontext((Scene*)instance->object,user_context);
+          pre.intersectEdge(ray,k,tri.v0,tri.e1,tri.e2,NormalSpaceMapper<M>(tri.getNormalSpace()),Intersect1KEpilogM<M,K,filter>(ray,k,&newcontext,tri.geomID(),tri.primID()));
+          instance_id_stack::pop(user_context);
+        }
+      }
+
+      static __forceinline bool occluded(Precalculations& pre, RayK<K>& ray, size_t k, IntersectContext* context, const Primitive& tri)
+      {
+        STAT3(shadow.trav_prims,1,1,1);
+        const Instance* instance = tri.getInstance();
+#if defined(EMBREE_RAY_MASK)
+        if ((ray.mask[k] & instance->mask) == 0)
+          return false;
+#endif
+        RTCIntersectContext* user_context = context->user;
+        bool occluded = false;
+        if (likely(instance_id_stack::push(user_context,tri.instID())))
+        {
+          IntersectContext newcontext((Scene*)instance->object,user_context);
+          occluded = pre.intersectEdge(ray,k,tri.v0,tri.e1,tri.e2,NormalSpaceMapper<M>(tri.getNormalSpace()),Occluded1KEpilogM<M,K,filter>(ray,k,&newcontext,tri.geomID(),tri.primID()));
+          instance_id_stack::pop(user_context);
+        }
+        return occluded;
+      }
+    };
+  }
+}
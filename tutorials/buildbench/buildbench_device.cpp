@@ -178,6 +178,7 @@ namespace embree {
     state.state->SetItemsProcessed(state.state->iterations() * numPrims);
     state.state->counters["Prims"] = ::benchmark::Counter(numPrims);
     state.state->counters["Objects"] = ::benchmark::Counter(numObjects);
+    state.state->counters["Mprims/s"] = ::benchmark::Counter(1E-6*numPrims, ::benchmark::Counter::kIsIterationInvariantRate);
   }
 #endif
   
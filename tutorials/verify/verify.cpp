@@ -3815,6 +3815,627 @@ namespace embree
     }
   };
 
+  /* traces rays through a scene using a device with some non-default
+   * configuration and compares the hits to a device with the default
+   * configuration */
+  struct DeviceConfigTest : public VerifyApplication::Test
+  {
+    std::string config;
+    SceneFlags sflags;
+    RTCBuildQuality quality;
+
+    DeviceConfigTest (std::string name, int isa, std::string config, SceneFlags sflags, RTCBuildQuality quality)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), config(config), sflags(sflags), quality(quality) {}
+
+    void createScene(VerifyScene& scene)
+    {
+      scene.addGeometry(quality,SceneGraph::createTriangleSphere(Vec3fa(-3,0,0),1.0f,50));
+      scene.addGeometry(quality,SceneGraph::createQuadSphere(Vec3fa(0,0,0),1.0f,50));
+      scene.addGeometry(quality,SceneGraph::createHairyPlane(17,Vec3fa(2,-1,-1),Vec3fa(2,0,0),Vec3fa(0,2,0),0.5f,0.02f,200,SceneGraph::ROUND_CURVE));
+      scene.addGeometry(quality,SceneGraph::convert_bezier_to_lines(SceneGraph::createHairyPlane(18,Vec3fa(-4.5f,1.5f,-1),Vec3fa(2,0,0),Vec3fa(0,2,0),0.5f,0.02f,200,SceneGraph::ROUND_CURVE)));
+      scene.addGeometry(quality,SceneGraph::createPointSphere(Vec3fa(3,3.5f,0),0.8f,0.05f,20,SceneGraph::SPHERE));
+      for (int i=0; i<3; i++)
+        scene.addGeometry(quality,new SceneGraph::TransformNode(AffineSpace3fa::translate(Vec3fa(-3.0f+3.0f*i,-3,0)),SceneGraph::createTriangleSphere(zero,1.0f,8)));
+    }
+
+    void trace(RTCScene scene, std::vector<RTCRayHit>& rays, std::vector<bool>& occluded)
+    {
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+      const size_t N = 64;
+      rays.resize(N*N); occluded.resize(N*N);
+      for (size_t y=0; y<N; y++) {
+        for (size_t x=0; x<N; x++) {
+          const Vec3fa org(-5.0f+10.0f*(x+0.5f)/N,-5.0f+10.0f*(y+0.5f)/N,-10.0f);
+          RTCRayHit& ray = rays[y*N+x];
+          ray = makeRay(org,Vec3fa(0,0,1));
+          rtcIntersect1(scene,&context,&ray);
+          RTCRayHit shadow = makeRay(org,Vec3fa(0,0,1));
+          rtcOccluded1(scene,&context,&shadow.ray);
+          occluded[y*N+x] = shadow.ray.tfar < 0.0f;
+        }
+      }
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device0 = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device0));
+      RTCDeviceRef device1 = rtcNewDevice((cfg+","+config).c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device1));
+
+      VerifyScene scene0(device0,sflags);
+      createScene(scene0);
+      rtcCommitScene(scene0);
+      AssertNoError(device0);
+
+      VerifyScene scene1(device1,sflags);
+      createScene(scene1);
+      rtcCommitScene(scene1);
+      AssertNoError(device1);
+
+      /* trace twice to also test rebuilds */
+      bool passed = true;
+      for (size_t i=0; i<2; i++)
+      {
+        std::vector<RTCRayHit> rays0, rays1;
+        std::vector<bool> occluded0, occluded1;
+        trace(scene0,rays0,occluded0);
+        trace(scene1,rays1,occluded1);
+        AssertNoError(device1);
+
+        for (size_t j=0; j<rays0.size(); j++)
+        {
+          passed &= occluded0[j] == occluded1[j];
+          passed &= rays0[j].hit.geomID == rays1[j].hit.geomID;
+          passed &= rays0[j].hit.instID[0] == rays1[j].hit.instID[0];
+          passed &= rays0[j].hit.geomID == RTC_INVALID_GEOMETRY_ID || abs(rays0[j].ray.tfar-rays1[j].ray.tfar) < 1E-4f;
+        }
+
+        rtcCommitScene(scene1);
+        AssertNoError(device1);
+      }
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct RayQueueTest : public VerifyApplication::Test
+  {
+    RayQueueTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    struct Results
+    {
+      std::vector<RTCRayHit> rays;
+      std::atomic<size_t> numRays;
+    };
+
+    static void callback(void* userPtr, RTCRayHit* rayhit, unsigned int M)
+    {
+      Results* results = (Results*) userPtr;
+      for (unsigned int i=0; i<M; i++)
+        results->rays[rayhit[i].ray.id] = rayhit[i];
+      results->numRays += M;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(Vec3fa(-3,0,0),1.0f,50));
+      scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createQuadSphere(Vec3fa(0,0,0),1.0f,50));
+      scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,new SceneGraph::TransformNode(AffineSpace3fa::translate(Vec3fa(3,0,0)),SceneGraph::createTriangleSphere(zero,1.0f,8)));
+      rtcCommitScene(scene);
+      AssertNoError(device);
+
+      /* create enough rays to fill many chunks of the queue */
+      const size_t N = 160;
+      std::vector<RTCRayHit> rays(N*N);
+      for (size_t y=0; y<N; y++) {
+        for (size_t x=0; x<N; x++) {
+          const Vec3fa org(-5.0f+10.0f*(x+0.5f)/N,-5.0f+10.0f*(y+0.5f)/N,-10.0f);
+          rays[y*N+x] = makeRay(org,Vec3fa(0,0,1));
+          rays[y*N+x].ray.id = (unsigned int)(y*N+x);
+        }
+      }
+
+      Results results;
+      results.rays.resize(rays.size());
+      results.numRays = 0;
+      RTCRayQueue queue = rtcNewRayQueue(scene,RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT,callback,&results);
+      AssertNoError(device);
+
+      /* enqueue batches of varying size, modify the scene before the final flush */
+      for (size_t i=0, M=1; i<rays.size(); i+=M, M=M*3+1)
+        rtcEnqueueRays(queue,&rays[i],(unsigned int)min(M,rays.size()-i),sizeof(RTCRayHit));
+      AssertNoError(device);
+      scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(Vec3fa(0,0,100),1.0f,8));
+      rtcFlushRayQueue(queue);
+      AssertError(device,RTC_ERROR_INVALID_OPERATION);
+
+      /* rays that could not get traced have to stay in the queue */
+      rtcCommitScene(scene);
+      rtcFlushRayQueue(queue);
+      AssertNoError(device);
+      rtcReleaseRayQueue(queue);
+
+      bool passed = results.numRays == rays.size();
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+      for (size_t i=0; i<rays.size(); i++)
+      {
+        RTCRayHit ray = rays[i];
+        rtcIntersect1(scene,&context,&ray);
+        passed &= ray.hit.geomID == results.rays[i].hit.geomID;
+        passed &= ray.hit.instID[0] == results.rays[i].hit.instID[0];
+        passed &= ray.hit.geomID == RTC_INVALID_GEOMETRY_ID || abs(ray.ray.tfar-results.rays[i].ray.tfar) < 1E-4f;
+      }
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct CompactOcclusionTest : public VerifyApplication::Test
+  {
+    CompactOcclusionTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(Vec3fa(-3,0,0),1.0f,50));
+      scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createQuadSphere(Vec3fa(0,0,0),1.0f,50));
+      scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(Vec3fa(3,0,0),1.0f,50));
+      rtcCommitScene(scene);
+      AssertNoError(device);
+
+      /* mix infinite shadow rays with rays ending behind and in front of the spheres */
+      const size_t N = 64;
+      const float tfars[3] = { float(inf), 12.0f, 5.0f };
+      std::vector<RTCRay> rays(N*N);
+      for (size_t y=0; y<N; y++) {
+        for (size_t x=0; x<N; x++) {
+          const Vec3fa org(-5.0f+10.0f*(x+0.5f)/N,-5.0f+10.0f*(y+0.5f)/N,-10.0f);
+          rays[y*N+x] = makeRay(org,Vec3fa(0,0,1)).ray;
+          rays[y*N+x].tnear = 0.5f;
+          rays[y*N+x].tfar = tfars[(y*N+x)%3];
+        }
+      }
+
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+      context.flags = (RTCIntersectContextFlags)(RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT | RTC_INTERSECT_CONTEXT_FLAG_COMPACT);
+      std::vector<RTCRay> rays1 = rays;
+      rtcOccluded1M(scene,&context,rays1.data(),(unsigned int)rays1.size(),sizeof(RTCRay));
+      AssertNoError(device);
+
+      rtcInitIntersectContext(&context);
+      bool passed = true;
+      size_t numOccluded = 0;
+      for (size_t i=0; i<rays.size(); i++)
+      {
+        RTCRay ray = rays[i];
+        rtcOccluded1(scene,&context,&ray);
+        passed &= (ray.tfar < 0.0f) == (rays1[i].tfar < 0.0f);
+        numOccluded += ray.tfar < 0.0f;
+      }
+      passed &= numOccluded > 0;
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct SceneStatisticsTest : public VerifyApplication::Test
+  {
+    SceneStatisticsTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    static bool pointQueryFunc(RTCPointQueryFunctionArguments* args) {
+      return false;
+    }
+
+    /* traces a grid of rays and returns the number of rays that hit */
+    size_t trace(RTCScene scene, RTCIntersectContextFlags flags, bool stream)
+    {
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+      context.flags = flags;
+      const size_t N = 64;
+      std::vector<RTCRayHit> rays(N*N);
+      for (size_t y=0; y<N; y++)
+        for (size_t x=0; x<N; x++)
+          rays[y*N+x] = makeRay(Vec3fa(-1.5f+3.0f*(x+0.5f)/N,-1.5f+3.0f*(y+0.5f)/N,-10.0f),Vec3fa(0,0,1));
+
+      if (stream)
+        rtcIntersect1M(scene,&context,rays.data(),(unsigned int)rays.size(),sizeof(RTCRayHit));
+      else
+        for (size_t i=0; i<rays.size(); i++)
+          rtcIntersect1(scene,&context,&rays[i]);
+
+      size_t numHits = 0;
+      for (size_t i=0; i<rays.size(); i++)
+        numHits += rays[i].hit.geomID != RTC_INVALID_GEOMETRY_ID;
+      return numHits;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_STATISTICS,RTC_BUILD_QUALITY_MEDIUM));
+      Ref<SceneGraph::Node> mesh = SceneGraph::createTriangleSphere(zero,1.0f,50);
+      scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,mesh);
+      rtcCommitScene(scene);
+      AssertNoError(device);
+
+      /* a point query with infinite radius visits every primitive exactly once */
+      bool passed = true;
+      RTCSceneStatistics stats;
+      RTCPointQuery query;
+      query.x = query.y = query.z = query.time = 0.0f;
+      query.radius = inf;
+      RTCPointQueryContext pcontext;
+      rtcInitPointQueryContext(&pcontext);
+      rtcPointQuery(scene,&query,&pcontext,pointQueryFunc,nullptr);
+      rtcGetSceneStatistics(scene,&stats);
+      passed &= stats.nodeVisits > 0 && stats.leafVisits > 0;
+      passed &= stats.primitiveTests == mesh->numPrimitives();
+
+      /* single rays, packets, and streams count visits per ray */
+      const RTCIntersectContextFlags flags[3] = { RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT, RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT, RTC_INTERSECT_CONTEXT_FLAG_COHERENT };
+      for (size_t i=0; i<3; i++)
+      {
+        /* enabling statistics again resets the counters */
+        rtcSetSceneFlags(scene,RTC_SCENE_FLAG_NONE);
+        rtcSetSceneFlags(scene,RTC_SCENE_FLAG_STATISTICS);
+        rtcGetSceneStatistics(scene,&stats);
+        passed &= stats.nodeVisits == 0 && stats.leafVisits == 0 && stats.primitiveTests == 0;
+
+        const size_t numHits = trace(scene,flags[i],i > 0);
+        rtcGetSceneStatistics(scene,&stats);
+        passed &= numHits > 0;
+        passed &= stats.nodeVisits >= numHits && stats.leafVisits >= numHits;
+        passed &= stats.primitiveTests >= stats.leafVisits;
+      }
+      AssertNoError(device);
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct FootprintDistanceFactorTest : public VerifyApplication::Test
+  {
+    FootprintDistanceFactorTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    /* traces a grid of rays and returns the number of rays that hit */
+    size_t trace(RTCScene scene, std::vector<RTCRayHit>& rays)
+    {
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+      const size_t N = 128;
+      rays.resize(N*N);
+      size_t numHits = 0;
+      for (size_t y=0; y<N; y++) {
+        for (size_t x=0; x<N; x++) {
+          RTCRayHit& ray = rays[y*N+x];
+          ray = makeRay(Vec3fa(-1.0f+2.0f*(x+0.5f)/N,-1.0f+2.0f*(y+0.5f)/N,-10.0f),Vec3fa(0,0,1));
+          rtcIntersect1(scene,&context,&ray);
+          numHits += ray.hit.geomID != RTC_INVALID_GEOMETRY_ID;
+        }
+      }
+      return numHits;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createHairyPlane(17,Vec3fa(-1,-1,0),Vec3fa(2,0,0),Vec3fa(0,2,0),0.5f,0.02f,400,SceneGraph::ROUND_CURVE));
+      rtcCommitScene(scene);
+      AssertNoError(device);
+
+      std::vector<RTCRayHit> rays0, rays1, rays2;
+      const size_t numHits0 = trace(scene,rays0);
+
+      /* a small footprint keeps the full precision intersection */
+      rtcSetSceneFootprintDistanceFactor(scene,1E-6f);
+      AssertNoError(device);
+      const size_t numHits1 = trace(scene,rays1);
+      bool passed = numHits0 > 0 && numHits0 == numHits1;
+      for (size_t i=0; i<rays0.size(); i++) {
+        passed &= rays0[i].hit.geomID == rays1[i].hit.geomID;
+        passed &= rays0[i].hit.geomID == RTC_INVALID_GEOMETRY_ID || rays0[i].ray.tfar == rays1[i].ray.tfar;
+      }
+
+      /* a footprint larger than the curves approximates the hits */
+      rtcSetSceneFootprintDistanceFactor(scene,0.05f);
+      AssertNoError(device);
+      const size_t numHits2 = trace(scene,rays2);
+      passed &= numHits2 > numHits0*9/10 && numHits2 < numHits0*11/10;
+
+      rtcSetSceneFootprintDistanceFactor(scene,-1.0f);
+      AssertError(device,RTC_ERROR_INVALID_ARGUMENT);
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct CollideInstancedTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+
+    CollideInstancedTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    /* spheres of the user geometry and the x-translations of the instances by instance ID */
+    static const Vec4f spheres[2];
+    static const float offsets[6];
+
+    struct Result
+    {
+      std::atomic<size_t> numCollisions;
+      std::atomic<bool> passed;
+    };
+
+    static RTCGeometry createInstance(RTCDevice device, RTCScene child, unsigned int instID)
+    {
+      const AffineSpace3fa xfm = AffineSpace3fa::translate(Vec3fa(offsets[instID],0.0f,0.0f));
+      RTCGeometry geom = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_INSTANCE);
+      rtcSetGeometryInstancedScene(geom, child);
+      rtcSetGeometryTransform(geom, 0, RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR, (float*)&xfm);
+      rtcCommitGeometry(geom);
+      return geom;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      auto boundsFunc = [](const struct RTCBoundsFunctionArguments* args)
+      {
+        const Vec4f& sphere = spheres[args->primID];
+        RTCBounds* bounds_o = args->bounds_o;
+        bounds_o->lower_x = sphere.x-sphere.w;
+        bounds_o->lower_y = sphere.y-sphere.w;
+        bounds_o->lower_z = sphere.z-sphere.w;
+        bounds_o->upper_x = sphere.x+sphere.w;
+        bounds_o->upper_y = sphere.y+sphere.w;
+        bounds_o->upper_z = sphere.z+sphere.w;
+      };
+      auto intersectFunc = [](const RTCIntersectFunctionNArguments* args) {};
+      auto occludedFunc  = [](const RTCOccludedFunctionNArguments* args)  {};
+
+      RTCSceneRef child = rtcNewScene(device);
+      rtcSetSceneFlags(child, sflags.sflags);
+      rtcSetSceneBuildQuality(child, sflags.qflags);
+      RTCGeometry geom = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_USER);
+      rtcSetGeometryUserPrimitiveCount(geom, 2);
+      rtcSetGeometryBoundsFunction(geom, boundsFunc, nullptr);
+      rtcSetGeometryIntersectFunction(geom, intersectFunc);
+      rtcSetGeometryOccludedFunction (geom, occludedFunc);
+      rtcCommitGeometry(geom);
+      rtcAttachGeometry(child, geom);
+      rtcReleaseGeometry(geom);
+      rtcCommitScene(child);
+      AssertNoError(device);
+
+      /* the spheres of the first instance only touch the spheres of the second one */
+      RTCSceneRef scene0 = rtcNewScene(device);
+      rtcSetSceneFlags(scene0, sflags.sflags);
+      rtcSetSceneBuildQuality(scene0, sflags.qflags);
+      RTCGeometry inst0 = createInstance(device,child,0);
+      rtcAttachGeometryByID(scene0, inst0, 0);
+      rtcReleaseGeometry(inst0);
+      rtcCommitScene(scene0);
+
+      RTCSceneRef scene1 = rtcNewScene(device);
+      rtcSetSceneFlags(scene1, sflags.sflags);
+      rtcSetSceneBuildQuality(scene1, sflags.qflags);
+      RTCGeometry inst5 = createInstance(device,child,5);
+      rtcAttachGeometryByID(scene1, inst5, 5);
+      rtcReleaseGeometry(inst5);
+      rtcCommitScene(scene1);
+      AssertNoError(device);
+
+      auto collideFunc = [](void* userPtr, RTCCollisionInstanced* collisions, unsigned int num_collisions)
+      {
+        Result* result = (Result*) userPtr;
+        for (unsigned int i=0; i<num_collisions; i++)
+        {
+          const RTCCollisionInstanced& c = collisions[i];
+          if (c.geomID0 != 0 || c.geomID1 != 0 || c.primID0 > 1 || c.primID1 > 1 || c.instID0[0] != 0 || c.instID1[0] != 5) {
+            result->passed = false;
+            continue;
+          }
+          for (unsigned int l=1; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+            if (c.instID0[l] != RTC_INVALID_GEOMETRY_ID || c.instID1[l] != RTC_INVALID_GEOMETRY_ID)
+              result->passed = false;
+
+          /* filters the potential collisions like a user would do */
+          const Vec4f s0 = spheres[c.primID0], s1 = spheres[c.primID1];
+          const float dx = (s0.x+offsets[c.instID0[0]])-(s1.x+offsets[c.instID1[0]]);
+          if (std::abs(dx) <= s0.w+s1.w)
+            result->numCollisions++;
+        }
+      };
+
+      Result result;
+      result.numCollisions = 0;
+      result.passed = true;
+      rtcCollideInstanced(scene0,scene1,collideFunc,&result);
+      AssertNoError(device);
+      bool passed = result.passed && result.numCollisions == 1;
+
+      /* collisions of instances cannot be reported without their instance IDs */
+      auto collideFuncNoInstances = [](void* userPtr, RTCCollision* collisions, unsigned int num_collisions) {};
+      rtcCollide(scene0,scene1,collideFuncNoInstances,nullptr);
+      AssertError(device,RTC_ERROR_INVALID_OPERATION);
+
+      /* user geometry scenes still collide without instance IDs */
+      rtcCollide(child,child,collideFuncNoInstances,nullptr);
+      AssertNoError(device);
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  const Vec4f CollideInstancedTest::spheres[2] = { Vec4f(0.0f,0.0f,0.0f,1.0f), Vec4f(3.0f,0.0f,0.0f,1.0f) };
+  const float CollideInstancedTest::offsets[6] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 3.0f };
+
+  static std::atomic<ssize_t> lazy_build_bytes_used(0);
+
+  struct LazyBuildTest : public VerifyApplication::Test
+  {
+    LazyBuildTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    static bool memoryMonitor(void* userPtr, const ssize_t bytes, const bool /*post*/)
+    {
+      lazy_build_bytes_used += bytes;
+      return true;
+    }
+
+    /* shoots a ray at the i'th instance and checks that it gets hit */
+    static bool hitInstance(RTCScene scene, unsigned int i)
+    {
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+      RTCRayHit ray = makeRay(Vec3fa(4.0f*i,0.0f,-10.0f),Vec3fa(0,0,1));
+      rtcIntersect1(scene,&context,&ray);
+      return ray.hit.instID[0] == i;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+",lazy_build_memory_budget=1";
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      lazy_build_bytes_used = 0;
+      rtcSetDeviceMemoryMonitorFunction(device,memoryMonitor,nullptr);
+
+      /* each lazily built scene takes more than the budget of 1 MB */
+      const unsigned int numScenes = 4;
+      std::vector<Ref<VerifyScene>> children;
+      VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      for (unsigned int i=0; i<numScenes; i++)
+      {
+        children.push_back(new VerifyScene(device,SceneFlags(RTC_SCENE_FLAG_LAZY_BUILD,RTC_BUILD_QUALITY_MEDIUM)));
+        children[i]->addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(zero,1.0f,100));
+        rtcCommitScene(*children[i]);
+
+        const AffineSpace3fa xfm = AffineSpace3fa::translate(Vec3fa(4.0f*i,0.0f,0.0f));
+        RTCGeometry geom = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_INSTANCE);
+        rtcSetGeometryInstancedScene(geom, *children[i]);
+        rtcSetGeometryTransform(geom, 0, RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR, (float*)&xfm);
+        rtcCommitGeometry(geom);
+        rtcAttachGeometryByID(scene, geom, i);
+        rtcReleaseGeometry(geom);
+      }
+      rtcCommitScene(scene);
+      AssertNoError(device);
+
+      /* the first frame builds all scenes, which are kept as all of them got visited */
+      bool passed = true;
+      const ssize_t bytes0 = lazy_build_bytes_used;
+      for (unsigned int i=0; i<numScenes; i++)
+        passed &= hitInstance(scene,i);
+      const ssize_t bytes1 = lazy_build_bytes_used;
+      rtcEvictLazyScenes(device);
+      AssertNoError(device);
+      passed &= bytes1 > bytes0 + ssize_t(numScenes)*1024*1024;
+      passed &= lazy_build_bytes_used == bytes1;
+
+      /* the second frame only visits the first scene, thus the others get freed */
+      passed &= hitInstance(scene,0);
+      rtcEvictLazyScenes(device);
+      AssertNoError(device);
+      const ssize_t bytes2 = lazy_build_bytes_used;
+      passed &= bytes2 < bytes1 - ssize_t(numScenes-1)*1024*1024;
+
+      /* freed scenes get rebuilt on their next visit */
+      for (unsigned int i=0; i<numScenes; i++)
+        passed &= hitInstance(scene,i);
+      AssertNoError(device);
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  static std::atomic<ssize_t> shared_accel_bytes_used(0);
+
+  struct SharedAccelTest : public VerifyApplication::Test
+  {
+    SharedAccelTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    static bool memoryMonitor(void* userPtr, const ssize_t bytes, const bool /*post*/)
+    {
+      shared_accel_bytes_used += bytes;
+      return true;
+    }
+
+    static RTCScene newScene(RTCDevice device, RTCGeometry geom)
+    {
+      RTCScene scene = rtcNewScene(device);
+      rtcSetSceneFlags(scene,RTC_SCENE_FLAG_DYNAMIC);
+      rtcAttachGeometry(scene,geom);
+      rtcCommitScene(scene);
+      return scene;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      shared_accel_bytes_used = 0;
+      rtcSetDeviceMemoryMonitorFunction(device,memoryMonitor,nullptr);
+
+      Ref<SceneGraph::TriangleMeshNode> mesh = SceneGraph::createTriangleSphere(zero,1.0f,100).dynamicCast<SceneGraph::TriangleMeshNode>();
+      RTCGeometry geom = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_TRIANGLE);
+      rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_INDEX,0,RTC_FORMAT_UINT3,mesh->triangles.data(),0,sizeof(SceneGraph::TriangleMeshNode::Triangle), mesh->triangles.size());
+      rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,0,RTC_FORMAT_FLOAT3,mesh->positions[0].data(),0,sizeof(SceneGraph::TriangleMeshNode::Vertex), mesh->positions[0].size());
+      rtcCommitGeometry(geom);
+      AssertNoError(device);
+
+      /* the second scene reuses the BVH the first scene built over the geometry */
+      bool passed = true;
+      const ssize_t bytes0 = shared_accel_bytes_used;
+      RTCScene scene0 = newScene(device,geom);
+      const ssize_t bytes1 = shared_accel_bytes_used;
+      RTCScene scene1 = newScene(device,geom);
+      const ssize_t bytes2 = shared_accel_bytes_used;
+      AssertNoError(device);
+      passed &= bytes2-bytes1 < (bytes1-bytes0)/2;
+
+      /* the shared BVH stays valid after the scene that built it got released */
+      rtcReleaseScene(scene0);
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+      RTCRayHit ray = makeRay(Vec3fa(0.0f,0.0f,-10.0f),Vec3fa(0,0,1));
+      rtcIntersect1(scene1,&context,&ray);
+      passed &= ray.hit.geomID == 0;
+
+      /* the BVH gets freed with the last scene that uses it, even though the geometry is still alive */
+      rtcReleaseScene(scene1);
+      passed &= shared_accel_bytes_used-bytes0 < (bytes1-bytes0)/2;
+
+      rtcReleaseGeometry(geom);
+      AssertNoError(device);
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
   struct GeometryStateTest : public VerifyApplication::Test
   {
     GeometryStateTest (std::string name, int isa)
@@ -5688,6 +6309,24 @@ namespace embree
       groups.top()->add(new SceneCheckModifiedGeometryTest("scene_modified_geometry_tests", isa));
       groups.top()->add(new SphereFilterMultiHitTest("sphere_filter_multi_hit_tests", isa));
 
+      push(new TestGroup("device_config",true,true));
+      groups.top()->add(new DeviceConfigTest("ploc",isa,"medium_quality_builder=ploc",SceneFlags(RTC_SCENE_FLAG_DYNAMIC,RTC_BUILD_QUALITY_LOW),RTC_BUILD_QUALITY_MEDIUM));
+      groups.top()->add(new DeviceConfigTest("ploc_radius_0",isa,"medium_quality_builder=ploc,ploc_search_radius=0",SceneFlags(RTC_SCENE_FLAG_DYNAMIC,RTC_BUILD_QUALITY_LOW),RTC_BUILD_QUALITY_MEDIUM));
+      groups.top()->add(new DeviceConfigTest("ploc_static",isa,"tri_builder=ploc,quad_builder=ploc",SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),RTC_BUILD_QUALITY_MEDIUM));
+      groups.top()->add(new DeviceConfigTest("autotune",isa,"autotune=1",SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),RTC_BUILD_QUALITY_MEDIUM));
+      groups.top()->add(new DeviceConfigTest("curve4q",isa,"hair_accel=bvh4obb.virtualcurve4q",SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),RTC_BUILD_QUALITY_MEDIUM));
+      groups.top()->add(new DeviceConfigTest("mixed_accel",isa,"mixed_accel=1",SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),RTC_BUILD_QUALITY_MEDIUM));
+      groups.top()->add(new DeviceConfigTest("instancing_flatten",isa,"instancing_flatten_threshold=1000",SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),RTC_BUILD_QUALITY_MEDIUM));
+      groups.pop();
+
+      groups.top()->add(new RayQueueTest("ray_queue",isa));
+      groups.top()->add(new CompactOcclusionTest("compact_occlusion",isa));
+      groups.top()->add(new SceneStatisticsTest("scene_statistics",isa));
+      groups.top()->add(new FootprintDistanceFactorTest("footprint_distance_factor",isa));
+      groups.top()->add(new CollideInstancedTest("collide_instanced",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM)));
+      groups.top()->add(new LazyBuildTest("lazy_build",isa));
+      groups.top()->add(new SharedAccelTest("shared_accel",isa));
+
       
       /**************************************************************************/
       /*                           Benchmarks                                   */
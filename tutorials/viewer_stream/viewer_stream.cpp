@@ -6,10 +6,19 @@
 
 namespace embree
 {
+  extern "C" {
+    bool g_compact_occlusion = false;
+  }
+
   struct Tutorial : public SceneLoadingTutorialApplication
   {
     Tutorial()
-      : SceneLoadingTutorialApplication("viewer_stream",FEATURE_RTCORE) {}
+      : SceneLoadingTutorialApplication("viewer_stream",FEATURE_RTCORE)
+    {
+      registerOption("compact_occlusion", [] (Ref<ParseStream> cin, const FileName& path) {
+          g_compact_occlusion = true;
+        }, "--compact_occlusion: use RTC_INTERSECT_CONTEXT_FLAG_COMPACT hint when tracing occlusion rays");
+    }
     
     void postParseCommandLine() override
     {
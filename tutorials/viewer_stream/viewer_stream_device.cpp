@@ -18,6 +18,7 @@ namespace embree {
 
 extern "C" ISPCScene* g_ispc_scene;
 extern "C" int g_instancing_mode;
+extern "C" bool g_compact_occlusion;
 
 /* scene data */
 RTCScene g_scene = nullptr;
@@ -154,6 +155,8 @@ Vec3fa ambientOcclusionShading(int x, int y, Ray& ray, RayStats& stats)
   RTCIntersectContext context;
   rtcInitIntersectContext(&context);
   context.flags = g_iflags_incoherent;
+  if (g_compact_occlusion)
+    context.flags = (RTCIntersectContextFlags)(context.flags | RTC_INTERSECT_CONTEXT_FLAG_COMPACT);
 
   /* trace occlusion rays */
 #if USE_INTERFACE == 0